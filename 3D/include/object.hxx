@@ -23,6 +23,7 @@
 #include <concepts>
 #include <cstddef>
 #include <matrix.hxx>
+#include <transform.hxx>
 #include <vec.hxx>
 
 namespace l3d {
@@ -115,6 +116,17 @@ class AbstractObject {
   std::vector<Vec3<FP>> get_default_vertices() const { return vertices; }
   // @return processed vertices, vertices that has been processed by faceIndices
   std::vector<Vec3<FP>> get_processed_vertices() const { return newVertices; }
+  /** @return processed vertices (atau default kalau belum ada face) yang sudah dikali model matrix
+   * @note dikerjakan batch dalam layout SoA, bukan Mat4 * Vec4 per vertex
+   */
+  std::vector<Vec3<FP>> get_world_vertices() const {
+    const auto&           src = newVertices.empty() ? vertices : newVertices;
+    PointsSoA<FP>         soa = aos_to_soa<FP>(src);
+    std::vector<Vec3<FP>> res(src.size());
+    transform_points(get_model_matrix(), soa, soa);
+    soa_to_aos<FP>(soa, res);
+    return res;
+  }
   // @return normals of the processed vertices, if not setted, will be calculated from processed vertices
   std::vector<Vec3<FP>> get_normals() const {
     const auto& src = newVertices.empty() ? vertices : newVertices;
@@ -338,7 +350,14 @@ class Object2D : public AbstractObject<FP, I> {
    * @note this is useful for 2D objects that should not move while the camera is moving, like UI elements
    */
   void bind_to_camera(const Camera<FP, I>& camera) {
-    AbstractObject<FP, I>::set_model_matrix(camera.get_view_matrix().inverse() * AbstractObject<FP, I>::get_model_matrix());
+    using Base = AbstractObject<FP, I>;
+    /* VIEW_MATRIX disimpan transpose (translasi di baris terakhir), inverse() tetap jalur affine
+     * dan transpose() membawanya ke konvensi model matrix (translasi di kolom terakhir)
+     */
+    const Mat4<FP> m = camera.get_view_matrix().inverse().transpose() * Base::get_model_matrix();
+    // get_model_matrix() = T(pos) · R · modelMat, jadi blok 3×3 dibagi R dan kolom translasi jadi pos baru
+    Base::set_model_matrix(Mat3<FP>(Base::get_rotation_matrix().transpose() * mat4_to_mat3(m)));
+    Base::translate_global(Vec3<FP>{m(0, 3), m(1, 3), m(2, 3)} - Base::get_translation());
   }
 };
 
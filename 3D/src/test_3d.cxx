@@ -17,6 +17,8 @@
   along with this program. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cmath>
 #include <debugger.hxx>
 #include <iomanip>
 #include <ios>
@@ -94,6 +96,16 @@ int main() {
 
   cout << "determinant m3 = " << m3.determinant() << endl;
 
+  // chain ini dievaluasi sekali jalan saat assignment, tanpa Mat sementara untuk + dan *skalar
+  cout << "elemen setelah operasi 2 * m3 + m3_2 * 0.5f - m3_2" << endl;
+  Linear::Mat3f chain = 2.0f * m3 + m3_2 * 0.5f - m3_2;
+  print(chain, 1);
+
+  cout << "elemen setelah operasi m3 *= m3_2 (in place)" << endl;
+  Linear::Mat3f inplace = m3;
+  inplace *= m3_2;
+  print(inplace, 1);
+
   // testing view matrix
   Linear::Vec3f eye{0, 0, 5}, lookAt{0, 0, 0};
   Linear::Mat4f vm = Linear::VIEW_MATRIX<float>(eye, lookAt);
@@ -121,6 +133,24 @@ int main() {
   l3d::Debugger<float, short> debugger;
   debugger.add_object("obj1", obj);
   debugger.run();
+  cout << "world vertices obj1 (batch transform)\t:" << endl;
+  for (const auto &v : obj.get_world_vertices()) cout << "\t" << v.x() << "\t" << v.y() << "\t" << v.z() << endl;
+
+  /* bind_to_camera: kamera di (2, 0, 0) menghadap +x, jadi titik ruang kamera (a, b, c)
+   * ada di dunia (2 - c, b, a). Rotasi dan translasi objek harus ikut, bukan cuma blok 3×3
+   */
+  l3d::Object2D<float, short> ui(Linear::Vec3f{1, 2, 0}, 2, 1);
+  ui.rotate_global({0, 0, 1}, M_PI / 2);
+  const auto                 before = ui.get_world_vertices();
+  l3d::Camera<float, short> cam({2, 0, 0}, {3, 0, 0});
+  ui.bind_to_camera(cam);
+  const auto after   = ui.get_world_vertices();
+  float      maxDiff = 0;
+  for (size_t i = 0; i < before.size(); ++i) {
+    const Linear::Vec3f expect{2 - before[i].z(), before[i].y(), before[i].x()};
+    for (int k = 0; k < 3; ++k) maxDiff = std::max(maxDiff, std::abs(after[i][k] - expect[k]));
+  }
+  cout << "max |bind_to_camera - expected|\t: " << maxDiff << endl;
 
-  return 0;
+  return maxDiff < 1e-5f ? 0 : 1;
 }
@@ -19,16 +19,27 @@
 
 #pragma once
 
+#include <aligned.hxx>
 #include <algorithm>
 #include <cmath>
 #include <concepts>
 #include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <gemm.hxx>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <nn_kernels.hxx>
+#include <nn_model_file.hxx>
+#include <nn_optimizer.hxx>
+#include <nn_profile.hxx>
+#include <nn_quant.hxx>
+#include <optional>
 #include <random>
+#include <type_traits>
+#include <vector>
 // #include <thread>
 
 namespace NN {
@@ -42,32 +53,66 @@ enum ACTIVATION_TYPE { RELU, SIGMOID, TANH };
 // perlu dimasukan ke parameter template karena semua array di dalamnya statis
 template <std::floating_point FP, size_t inputSize, size_t hidden1Size, size_t hidden2Size, size_t outputSize>
 class BasicFFN {
-  ACTIVATION_TYPE    act_t;
-  LOSS_TYPE          loss_t;
-  FP               **wIn, **wHid1, **wHid2;
-  FP                *bIn, *bHid1, *bHid2;
-  FP                *toHid1, *toHid2, *out;
-  FP                *dOut, *dHid2, *dHid1;
-  FP                 lastLoss         = -1;
-  bool               debug            = false;
-  std::string        weights_filename = "";
-  inline static FP   epsilon          = 1e-6;  // untuk mencegah dead neuron ketika menggunakan ReLU
-  bool               xavier           = false;
-  FP                 eta              = 1e-2;
-  std::random_device rd;
-  std::mt19937       gen;
-  // FP = Floating Point @param FP1 current eta/learning rate @param FP2 grad
-  FP (*adaptive_eta_func)(FP, FP);
+  /* Bobot satu layer disimpan transpose dalam satu blok kontigu yang rata 64 byte:
+   * baris ke-o berisi semua bobot yang masuk ke neuron output o, jadi forward
+   * cuma dot product unit stride per neuron. Tiap baris dipad ke kelipatan
+   * cache line supaya awal barisnya juga rata, padding selalu 0.
+   */
+  template <size_t inSize, size_t outSize>
+  struct Layer {
+    static constexpr size_t    stride = Linear::pad_to_cache_line<FP>(inSize);
+    Linear::aligned_vector<FP> w      = Linear::aligned_vector<FP>(outSize * stride);
+    Linear::aligned_vector<FP> b      = Linear::aligned_vector<FP>(outSize);
+
+    FP       *row(size_t o) { return w.data() + o * stride; }
+    const FP *row(size_t o) const { return w.data() + o * stride; }
+    // indeksnya sama dengan layout lama w[in][out], dipakai untuk file dan debug
+    FP       &at(size_t in, size_t o) { return w[o * stride + in]; }
+
+    // bobot sebagai matriks outSize × inSize (Wᵀ dari sudut pandang x · W)
+    Linear::MatrixView<FP>       view() { return Linear::MatrixView<FP>(w.data(), outSize, inSize, stride, 1); }
+    Linear::MatrixView<const FP> view() const { return Linear::MatrixView<const FP>(w.data(), outSize, inSize, stride, 1); }
+
+    // gradien batch dengan layout yang sama dengan w, baru dialokasikan oleh set_optimizer()
+    Linear::aligned_vector<FP> gw, gb;
+    size_t                     wId = 0, bId = 0;
+    Linear::MatrixView<FP>     grad_view() { return Linear::MatrixView<FP>(gw.data(), outSize, inSize, stride, 1); }
+  };
+
+  using Buffer = Linear::aligned_vector<FP>;
+
+  ACTIVATION_TYPE                 act_t;
+  LOSS_TYPE                       loss_t;
+  Layer<inputSize, hidden1Size>   lIn;
+  Layer<hidden1Size, hidden2Size> lHid1;
+  Layer<hidden2Size, outputSize>  lHid2;
+  Buffer                          toHid1 = Buffer(hidden1Size), toHid2 = Buffer(hidden2Size), out = Buffer(outputSize);
+  Buffer                          dOut = Buffer(outputSize), dHid2 = Buffer(hidden2Size), dHid1 = Buffer(hidden1Size);
+  FP                              lastLoss         = -1;
+  bool                            debug            = false;
+  std::string                     weights_filename = "";
+  FP                              epsilon          = 1e-6;  // untuk mencegah dead neuron ketika menggunakan ReLU, per instance
+  bool                            precise          = false;  // per instance, dibaca saat aktivasi
+  bool                            xavier           = false;
+  FP                              eta              = 1e-2;
+  // aktivasi dan delta untuk train_batch, satu baris per sampel, dipakai ulang antar batch
+  Linear::Matrix<FP>              bHid1, bHid2, bOut, bdHid1, bdHid2, bdOut;
+  std::random_device              rd;
+  std::mt19937                    gen;
+  // kosong = SGD biasa yang digabung ke gemm di train_batch
+  std::optional<Optimizer<FP>>    opt;
+  // waktu per layer train_batch/forward_batch, 0 = lIn, 1 = lHid1, 2 = lHid2
+  LayerProfiler                   prof;
 
   // setiap layer punya distribusi yang berbeda
   template <size_t inSize, size_t outSize>
-  void init_layer(FP k, FP **w, FP *b) {
+  void init_layer(FP k, Layer<inSize, outSize> &l) {
     // setup normal distribution
     std::normal_distribution<FP> dis(0, std::sqrt(2 / k));
 
     for (size_t i = 0; i < outSize; ++i) {
-      for (size_t j = 0; j < inSize; ++j) w[j][i] = dis(gen);
-      b[i] = 0;
+      for (size_t j = 0; j < inSize; ++j) l.at(j, i) = dis(gen);
+      l.b[i] = 0;
     }
   }
 
@@ -83,141 +128,294 @@ class BasicFFN {
       k1 += hidden2Size;
       k2 += outputSize;
     }
-    init_layer<inputSize, hidden1Size>(k0, wIn, bIn);
-    init_layer<hidden1Size, hidden2Size>(k1, wHid1, bHid1);
-    init_layer<hidden2Size, outputSize>(k2, wHid2, bHid2);
+    init_layer(k0, lIn);
+    init_layer(k1, lHid1);
+    init_layer(k2, lHid2);
   }
 
-  FP **allocate_2d(size_t rows, size_t cols) {
-    FP **mat = new FP *[rows];
-    for (size_t i = 0; i < rows; ++i) mat[i] = new FP[cols]{};
-    return mat;
+  // Activation func
+  FP ReLU(FP x) const { return x > 0 ? x : epsilon; }
+  FP ReLU_deriv(FP y) const { return y > 0 ? 1 : epsilon; }
+  // Precise = false pendekatan cepat dari nn_kernels.hxx, true kembali ke std::exp/std::tanh
+  template <bool Precise>
+  static FP sigmoid(FP x) { return Precise ? 1 / (1 + std::exp(-x)) : kernel::fast_sigmoid(x); }
+  static FP sigmoid_deriv(FP y) { return y * (1 - y); }
+  template <bool Precise>
+  static FP tanh(FP x) { return Precise ? std::tanh(x) : kernel::fast_tanh(x); }
+  static FP tanh_deriv(FP y) { return 1 - y * y; }
+
+  // aktivasi dipilih saat compile, jadi inline ke loop layer tanpa pointer fungsi
+  template <ACTIVATION_TYPE A, bool Precise>
+  FP activate(FP x) const {
+    if constexpr (A == RELU) return ReLU(x);
+    else if constexpr (A == SIGMOID) return sigmoid<Precise>(x);
+    else return tanh<Precise>(x);
   }
 
-  void deallocate_2d(FP **mat, size_t rows) {
-    for (size_t i = 0; i < rows; ++i) delete[] mat[i];
-    delete[] mat;
+  // y = act(y) untuk satu baris, cabang precise sekali di luar loop seperti apply_activation di dynFFN
+  template <ACTIVATION_TYPE A>
+  void activate_row(FP *y, size_t n) const {
+    if (precise)
+      for (size_t i = 0; i < n; ++i) y[i] = activate<A, true>(y[i]);
+    else {
+#pragma omp simd
+      for (size_t i = 0; i < n; ++i) y[i] = activate<A, false>(y[i]);
+    }
+  }
+  template <ACTIVATION_TYPE A>
+  FP activate_deriv(FP y) const {
+    if constexpr (A == RELU) return ReLU_deriv(y);
+    else if constexpr (A == SIGMOID) return sigmoid_deriv(y);
+    else return tanh_deriv(y);
   }
 
-  // Activation func
-  static FP ReLU(FP x) { return x > 0 ? x : epsilon; }
-  static FP ReLU_deriv(FP y) { return y > 0 ? 1 : epsilon; }
-  static FP sigmoid(FP x) { return 1 / (1 + std::exp(-x)); }
-  static FP sigmoid_deriv(FP y) { return y * (1 - y); }
-  static FP tanh(FP x) { return (std::exp(x) - std::exp(-x)) / (std::exp(x) + std::exp(-x)); }
-  static FP tanh_deriv(FP y) { return 1 - y * y; }
+  // switch act_t sekali di luar, f dipanggil dengan std::integral_constant<ACTIVATION_TYPE, ...>
+  template <typename F>
+  decltype(auto) with_activation(F &&f) {
+    switch (act_t) {
+      case SIGMOID: return f(std::integral_constant<ACTIVATION_TYPE, SIGMOID>{});
+      case TANH: return f(std::integral_constant<ACTIVATION_TYPE, TANH>{});
+      default: return f(std::integral_constant<ACTIVATION_TYPE, RELU>{});
+    }
+  }
 
   /* Agar lebih mudah dibaca, layer layernya diabstraksi jadi fungsi independen.
-  Untuk performa sih lebih baik di unwrap karena nambah overhead untuk
-  pemanggilan fungsi kalau diabstraksi semua. Lebih bagus lagi kalau di taruh di
-  shader compute GPU, atau pake Tensorflownya CUDA sekalian. Next time bakal
-  diunwrap
+  Aktivasi sudah jadi parameter template, jadi setelah inline overheadnya hilang.
   */
-  // fungsi untuk forward per layer, @actFunc pointer fungsi aktivasi atau 0
-  // alias nullptr jika tidak
-  template <size_t inSize, size_t outSize>
-  void forward_layer(FP **w, FP *b, FP *dataIn, FP *dataOut, FP (*actFunc)(FP)) {
+  // fungsi untuk forward per layer, Activate = false untuk layer tanpa aktivasi
+  template <ACTIVATION_TYPE A, bool Activate, size_t inSize, size_t outSize>
+  void forward_layer(const Layer<inSize, outSize> &l, const FP *dataIn, FP *dataOut) {
+#pragma omp parallel for schedule(static) if (inSize * outSize >= (1 << 18))
+    for (size_t i = 0; i < outSize; ++i) dataOut[i] = kernel::dot(l.row(i), dataIn, inSize) + l.b[i];
+    if constexpr (Activate) activate_row<A>(dataOut, outSize);
+  }
+
+  /* fungsi untuk backward per layer
+  @param deltaIn delta neuron output layer ini
+  @param deltaOut delta neuron input layer ini (dihitung dengan bobot yang sudah diupdate), nullptr kalau tidak perlu
+  @param Deriv false kalau tidak perlu dikali turunan aktivasi
+   */
+  template <ACTIVATION_TYPE A, bool Deriv, size_t inSize, size_t outSize>
+  void backward_layer(Layer<inSize, outSize> &l, const FP *dataIn, const FP *deltaIn, FP *deltaOut, FP eta) {
+    // update bobot dan bias berdasarkan delta in, satu baris = satu neuron output
+#pragma omp parallel for schedule(static) if (inSize * outSize >= (1 << 18))
     for (size_t i = 0; i < outSize; ++i) {
-      for (size_t j = 0; j < inSize; ++j) dataOut[i] += w[j][i] * dataIn[j];
-      dataOut[i] += b[i];
-      if (actFunc) dataOut[i] = actFunc(dataOut[i]);
+      kernel::axpy(-eta * deltaIn[i], dataIn, l.row(i), inSize);
+      l.b[i] -= eta * deltaIn[i];
     }
+
+    if (!deltaOut) return;
+    // deltaOut = Wᵀ deltaIn, di layout transpose jadi akumulasi baris
+    std::fill(deltaOut, deltaOut + inSize, FP(0));
+    for (size_t i = 0; i < outSize; ++i) kernel::axpy(deltaIn[i], l.row(i), deltaOut, inSize);
+    // aturan rantai
+    if constexpr (Deriv)
+      for (size_t i = 0; i < inSize; ++i) deltaOut[i] *= activate_deriv<A>(dataIn[i]);
   }
 
-  /* fungsi untuk backward per layer
-  @param inSize parameter template untuk ukuran layer masuk (dari belakang)
-  @param outSize parameter template untuk ukuran layer keluar (dari belakang)
-  @param actFuncDeriv pointer ke turunan fungsi aktivasi
+  /* format file tetap sama dengan versi FP** lama: baris per input, isinya
+   * bobot ke semua output. Dikonversi lewat satu baris buffer.
    */
   template <size_t inSize, size_t outSize>
-  void backward_layer(FP **w, FP *b, FP *dataIn, FP *deltaIn, FP *(*deltaOut), FP (*actFuncDeriv)(FP), FP eta) {
-    // update bobot dan bias berdasarkan delta in
+  void write_matrix(std::ofstream &ofs, Layer<inSize, outSize> &l) {
+    std::vector<FP> buf(outSize);
     for (size_t i = 0; i < inSize; ++i) {
-      for (size_t j = 0; j < outSize; ++j) w[j][i] -= eta * deltaIn[i] * dataIn[j];
-      b[i] -= eta * deltaIn[i];
+      for (size_t j = 0; j < outSize; ++j) buf[j] = l.at(i, j);
+      ofs.write(reinterpret_cast<char *>(buf.data()), sizeof(FP) * outSize);
     }
+  }
 
-    if (!deltaOut) return;
-    // update delta Out jika disediakan
-    for (size_t i = 0; i < outSize; ++i) {
-      for (size_t j = 0; j < inSize; ++j) (*deltaOut)[i] += w[i][j] * deltaIn[j];
-      // aturan rantai
-      if (actFuncDeriv) (*deltaOut)[i] *= actFuncDeriv(dataIn[i]);
+  template <size_t inSize, size_t outSize>
+  void read_matrix(std::ifstream &ifs, Layer<inSize, outSize> &l) {
+    std::vector<FP> buf(outSize);
+    for (size_t i = 0; i < inSize; ++i) {
+      ifs.read(reinterpret_cast<char *>(buf.data()), sizeof(FP) * outSize);
+      for (size_t j = 0; j < outSize; ++j) l.at(i, j) = buf[j];
     }
   }
 
-  void write_matrix(std::ofstream &ofs, FP **mat, size_t rows, size_t cols) {
-    for (size_t i = 0; i < rows; ++i) ofs.write(reinterpret_cast<char *>(mat[i]), sizeof(FP) * cols);
+  // cross entropy butuh epsilon instance, jadi loss dipilih lewat member bukan pointer fungsi
+  FP loss(FP ypred, FP y) const {
+    switch (loss_t) {
+      case LOSS_TYPE::MAE: return MAE(ypred, y);
+      case LOSS_TYPE::CROSS_ENTROPY: return cross_entropy_loss(ypred, y);
+      default: return MSE(ypred, y);
+    }
+  }
+  FP loss_deriv(FP ypred, FP y) const {
+    switch (loss_t) {
+      case LOSS_TYPE::MAE: return MAE_deriv(ypred, y);
+      case LOSS_TYPE::CROSS_ENTROPY: return cross_entropy_loss_deriv(ypred, y);
+      default: return MSE_deriv(ypred, y);
+    }
   }
 
-  void read_matrix(std::ifstream &ifs, FP **mat, size_t rows, size_t cols) {
-    for (size_t i = 0; i < rows; ++i) ifs.read(reinterpret_cast<char *>(mat[i]), sizeof(FP) * cols);
+  // file model menyimpan ld yang sama dengan stride Layer, jadi cukup satu memcpy per tensor
+  template <size_t inSize, size_t outSize>
+  static void copy_layer(const model::MappedModel<FP> &m, size_t l, Layer<inSize, outSize> &dst) {
+    const auto W = m.weights(l);
+    if (W.row_stride() == dst.stride) std::memcpy(dst.w.data(), W.data(), sizeof(FP) * outSize * dst.stride);
+    else
+      for (size_t o = 0; o < outSize; ++o) std::copy_n(W.row(o).data(), inSize, dst.row(o));
+    std::copy_n(m.bias(l), outSize, dst.b.data());
+  }
+
+  model::MODEL_ACTIVATION model_activation() const { return act_t == SIGMOID ? model::ACT_SIGMOID : act_t == TANH ? model::ACT_TANH : model::ACT_RELU; }
+
+  template <ACTIVATION_TYPE A>
+  FP *forward_impl(const FP *data) {
+    // input data to the input layer
+    forward_layer<A, false>(lIn, data, toHid1.data());
+    // hidden layer
+    forward_layer<A, true>(lHid1, toHid1.data(), toHid2.data());
+    forward_layer<A, true>(lHid2, toHid2.data(), out.data());
+    return out.data();
+  }
+
+  template <ACTIVATION_TYPE A>
+  void backward_impl(const FP *inputData, const FP *targetData) {
+    forward_impl<A>(inputData);
+
+    // calculate dOut first for update through backward_layer template function
+    lastLoss = 0;
+    for (size_t i = 0; i < outputSize; ++i) {
+      lastLoss += loss(out[i], targetData[i]) / outputSize;
+      dOut[i]   = loss_deriv(out[i], targetData[i]) * activate_deriv<A>(out[i]);
+    }
+
+    backward_layer<A, true>(lHid2, toHid2.data(), dOut.data(), dHid2.data(), eta);
+    backward_layer<A, true>(lHid1, toHid1.data(), dHid2.data(), dHid1.data(), eta);
+    backward_layer<A, false>(lIn, inputData, dHid1.data(), nullptr, eta);
+  }
+
+  /* Y = act(X · Wᵀ + b) untuk satu batch sekaligus, bias dan aktivasi
+   * dikerjakan per baris setelah gemm
+   */
+  template <ACTIVATION_TYPE A, bool Activate, size_t inSize, size_t outSize>
+  void forward_batch_layer(const Layer<inSize, outSize> &l, Linear::MatrixView<const FP> X, Linear::Matrix<FP> &Y) {
+    Linear::gemm<FP>(1, X, l.view().transposed(), 0, Y);
+#pragma omp parallel for schedule(static) if (Y.size() >= (1 << 14))
+    for (size_t r = 0; r < Y.rows(); ++r) {
+      FP *y = Y.row(r).data();
+#pragma omp simd
+      for (size_t i = 0; i < outSize; ++i) y[i] += l.b[i];
+      if constexpr (Activate) activate_row<A>(y, outSize);
+    }
+  }
+
+  // D = (Dnext · W) ⊙ act'(H), memakai bobot sebelum diupdate
+  template <ACTIVATION_TYPE A, bool Deriv, size_t inSize, size_t outSize>
+  void backward_batch_delta(const Layer<inSize, outSize> &l, const Linear::Matrix<FP> &Dnext, const Linear::Matrix<FP> &H, Linear::Matrix<FP> &D) {
+    Linear::gemm<FP>(1, Dnext, l.view(), 0, D);
+    if constexpr (Deriv) {
+#pragma omp parallel for schedule(static) if (D.size() >= (1 << 14))
+      for (size_t r = 0; r < D.rows(); ++r) {
+        FP *d = D.row(r).data();
+        const FP *h = H.row(r).data();
+#pragma omp simd
+        for (size_t i = 0; i < inSize; ++i) d[i] *= activate_deriv<A>(h[i]);
+      }
+    }
+  }
+
+  /* Tanpa optimizer: W -= (eta / batch) · Dᵀ · X, b -= (eta / batch) · Σ baris D.
+   * Dengan optimizer gradiennya ditulis ke gw/gb lalu satu pass fused per tensor,
+   * padding baris ikut diupdate tapi gradiennya selalu 0.
+   */
+  template <size_t inSize, size_t outSize>
+  void update_batch_layer(Layer<inSize, outSize> &l, const Linear::Matrix<FP> &D, Linear::MatrixView<const FP> X) {
+    const size_t batch = D.rows();
+    if (!opt) {
+      const FP scale = eta / batch;
+      Linear::gemm<FP>(-scale, D.transposed(), X, 1, l.view());
+      for (size_t r = 0; r < batch; ++r) kernel::axpy(-scale, D.row(r).data(), l.b.data(), outSize);
+      return;
+    }
+    Linear::gemm<FP>(1, D.transposed(), X, 0, l.grad_view());
+    std::fill(l.gb.begin(), l.gb.end(), FP(0));
+    for (size_t r = 0; r < batch; ++r) kernel::axpy(FP(1), D.row(r).data(), l.gb.data(), outSize);
+    opt->update(l.wId, l.w.data(), l.gw.data(), FP(1) / batch);
+    opt->update(l.bId, l.b.data(), l.gb.data(), FP(1) / batch);
+  }
+
+  template <size_t inSize, size_t outSize>
+  void attach_optimizer(Layer<inSize, outSize> &l) {
+    l.gw.assign(l.w.size(), 0);
+    l.gb.assign(outSize, 0);
+    l.wId = opt->add_tensor(l.w.size());
+    l.bId = opt->add_tensor(outSize, false);
+  }
+
+  template <ACTIVATION_TYPE A>
+  void train_batch_impl(const FP *X, const FP *Y, size_t batch) {
+    const Linear::MatrixView<const FP> Xv(X, batch, inputSize, inputSize, 1);
+    bdHid1.resize(batch, hidden1Size);
+    bdHid2.resize(batch, hidden2Size);
+    bdOut.resize(batch, outputSize);
+
+    forward_batch_impl<A>(Xv, batch);
+
+    FP batchLoss = 0;
+#pragma omp parallel for reduction(+ : batchLoss) schedule(static) if (batch * outputSize >= (1 << 14))
+    for (size_t r = 0; r < batch; ++r)
+      for (size_t i = 0; i < outputSize; ++i) {
+        const FP o = bOut(r, i), y = Y[r * outputSize + i];
+        batchLoss  += loss(o, y) / outputSize;
+        bdOut(r, i) = loss_deriv(o, y) * activate_deriv<A>(o);
+      }
+    lastLoss = batchLoss / batch;
+
+    // semua delta dihitung dulu dengan bobot lama, baru satu update rata-rata per batch
+    prof.time_backward(2, [&] { backward_batch_delta<A, true>(lHid2, bdOut, bHid2, bdHid2); });
+    prof.time_backward(1, [&] { backward_batch_delta<A, true>(lHid1, bdHid2, bHid1, bdHid1); });
+
+    if (opt) opt->begin_step();
+    prof.time_backward(2, [&] { update_batch_layer(lHid2, bdOut, bHid2); });
+    prof.time_backward(1, [&] { update_batch_layer(lHid1, bdHid2, bHid1); });
+    prof.time_backward(0, [&] { update_batch_layer(lIn, bdHid1, Xv); });
+  }
+
+  template <ACTIVATION_TYPE A>
+  void forward_batch_impl(Linear::MatrixView<const FP> Xv, size_t batch) {
+    bHid1.resize(batch, hidden1Size);
+    bHid2.resize(batch, hidden2Size);
+    bOut.resize(batch, outputSize);
+    prof.time_forward(0, [&] { forward_batch_layer<A, false>(lIn, Xv, bHid1); });
+    prof.time_forward(1, [&] { forward_batch_layer<A, true>(lHid1, bHid1, bHid2); });
+    prof.time_forward(2, [&] { forward_batch_layer<A, true>(lHid2, bHid2, bOut); });
   }
 
  public:
   // default activation using ReLU
-  explicit BasicFFN(ACTIVATION_TYPE act_t = ACTIVATION_TYPE::RELU, LOSS_TYPE loss_t = LOSS_TYPE::MSE) : act_t(act_t), loss_t(loss_t) {
-    wIn    = allocate_2d(inputSize, hidden1Size);
-    wHid1  = allocate_2d(hidden1Size, hidden2Size);
-    wHid2  = allocate_2d(hidden2Size, outputSize);
-    bIn    = new FP[hidden1Size];
-    bHid1  = new FP[hidden2Size];
-    bHid2  = new FP[outputSize];
-    toHid1 = new FP[hidden1Size];
-    toHid2 = new FP[hidden2Size];
-    out    = new FP[outputSize]{};
-    dHid1  = new FP[hidden1Size];
-    dHid2  = new FP[hidden2Size];
-    dOut   = new FP[outputSize];
-    init_wb();
-  }
+  explicit BasicFFN(ACTIVATION_TYPE act_t = ACTIVATION_TYPE::RELU, LOSS_TYPE loss_t = LOSS_TYPE::MSE) : act_t(act_t), loss_t(loss_t) { init_wb(); }
   explicit BasicFFN(ACTIVATION_TYPE act_t, LOSS_TYPE loss_t, std::string weightfilename) : act_t(act_t), loss_t(loss_t), weights_filename(weightfilename) {
-    wIn    = allocate_2d(inputSize, hidden1Size);
-    wHid1  = allocate_2d(hidden1Size, hidden2Size);
-    wHid2  = allocate_2d(hidden2Size, outputSize);
-    bIn    = new FP[hidden1Size];
-    bHid1  = new FP[hidden2Size];
-    bHid2  = new FP[outputSize];
-    toHid1 = new FP[hidden1Size];
-    toHid2 = new FP[hidden2Size];
-    out    = new FP[outputSize]{};
-    dHid1  = new FP[hidden1Size];
-    dHid2  = new FP[hidden2Size];
-    dOut   = new FP[outputSize];
     load_weights();
   }
 
   // set epsilon if using ReLU to avoid dead neuron, @param epsilon default 1e-6
-  void set_epsilon(FP epsilon) { BasicFFN::epsilon = epsilon; }
-  void set_learning_rate(FP eta) { this->eta = eta; }
-  void set_adaptive_learning_rate_func(FP (*adaptive_eta_func)(FP, FP)) { this->adaptive_eta_func = adaptive_eta_func; }
+  void set_epsilon(FP epsilon) { this->epsilon = epsilon; }
+  void set_learning_rate(FP eta) {
+    this->eta = eta;
+    if (opt) opt->set_lr(eta);
+  }
+  // sigmoid/tanh pakai std::exp/std::tanh penuh, default pendekatan cepat
+  void set_precise_activation(bool p) { precise = p; }
+  /* Optimizer ber-state (momentum, Adam, AdamW) untuk train_batch, menggantikan
+   * SGD bawaan. backward() per sampel tetap SGD dengan eta.
+   */
+  void set_optimizer(const OptimizerConfig<FP> &cfg) {
+    opt.emplace(cfg);
+    eta = cfg.lr;
+    attach_optimizer(lIn);
+    attach_optimizer(lHid1);
+    attach_optimizer(lHid2);
+  }
 
   /* return output in array
   @note array will be lost after class is destroyed
   */
-  FP *forward(FP *data) {
-    // zeroing data layer agar tidak menumpuk
-    std::fill(toHid1, toHid1 + hidden1Size, 0);
-    std::fill(toHid2, toHid2 + hidden2Size, 0);
-    std::fill(out, out + outputSize, 0);
-
-    // lambda switch for mathing activation function
-    auto actFuncFromType = [](ACTIVATION_TYPE act_t) {
-      switch (act_t) {
-        case ACTIVATION_TYPE::RELU: return ReLU;
-        case ACTIVATION_TYPE::SIGMOID: return sigmoid;
-        case ACTIVATION_TYPE::TANH: return tanh;
-      }
-    };
-    auto actFunc = actFuncFromType(act_t);
-
-    // input data to the input layer
-    forward_layer<inputSize, hidden1Size>(wIn, bIn, data, toHid1, 0);
-    // hidden layer
-    forward_layer<hidden1Size, hidden2Size>(wHid1, bHid1, toHid1, toHid2, actFunc);
-    forward_layer<hidden2Size, outputSize>(wHid2, bHid2, toHid2, out, actFunc);
-
-    return out;
+  FP *forward(const FP *data) {
+    return with_activation([&](auto A) { return forward_impl<decltype(A)::value>(data); });
   }
 
   // Loss function section
@@ -233,79 +431,36 @@ class BasicFFN {
   // Derivative of Mean Squared Error
   static FP MSE_deriv(FP ypred, FP y) { return ypred - y; }
 
-  static FP cross_entropy_loss(FP ypred, FP y) { return -y * std::log(ypred + epsilon) - (1 - y) * std::log(1 - ypred + epsilon); }
-  static FP cross_entropy_loss_deriv(FP ypred, FP y) { return (ypred - y) / ((ypred + epsilon) * (1 - ypred + epsilon)); }
+  FP cross_entropy_loss(FP ypred, FP y) const { return -y * std::log(ypred + epsilon) - (1 - y) * std::log(1 - ypred + epsilon); }
+  FP cross_entropy_loss_deriv(FP ypred, FP y) const { return (ypred - y) / ((ypred + epsilon) * (1 - ypred + epsilon)); }
 
   /* using w = wcurr - eta * dL/dw
    using b = bcurr - eta * dL/db;
    */
-  void backward(FP *inputData, FP *targetData) {
-    forward(inputData);
-    // zeroing delta layer agar tidak menumpuk
-    std::fill(dOut, dOut + outputSize, 0);
-    std::fill(dHid2, dHid2 + hidden2Size, 0);
-    std::fill(dHid1, dHid1 + hidden1Size, 0);
-
-    // lambda switch for mathing activation function derivative
-    auto actFuncDerivFromType = [](ACTIVATION_TYPE act_t) {
-      switch (act_t) {
-        case ACTIVATION_TYPE::RELU: return ReLU_deriv;
-        case ACTIVATION_TYPE::SIGMOID: return sigmoid_deriv;
-        case ACTIVATION_TYPE::TANH: return tanh_deriv;
-      }
-    };
-    auto actFuncDeriv = actFuncDerivFromType(act_t);
-
-    auto lossDerivFuncFromType = [](LOSS_TYPE loss_t) {
-      switch (loss_t) {
-        case LOSS_TYPE::MAE: return MAE_deriv;
-        case LOSS_TYPE::MSE: return MSE_deriv;
-        case LOSS_TYPE::CROSS_ENTROPY: return cross_entropy_loss_deriv;
-      }
-    };
-    auto lossDerivFunc    = lossDerivFuncFromType(loss_t);
-    auto lossFuncFromType = [](LOSS_TYPE loss_t) {
-      switch (loss_t) {
-        case LOSS_TYPE::MAE: return MAE;
-        case LOSS_TYPE::MSE: return MSE;
-        case LOSS_TYPE::CROSS_ENTROPY: return cross_entropy_loss;
-      }
-    };
-
-    auto lossFunc = lossFuncFromType(loss_t);
-
-    // calculate dOut first for update through backward_layer template function
-    lastLoss = 0;
-    for (size_t i = 0; i < outputSize; ++i) {
-      lastLoss += lossFunc(out[i], targetData[i]) / outputSize;
-      dOut[i]   = lossDerivFunc(out[i], targetData[i]) * actFuncDeriv(out[i]);
-    }
-
-    backward_layer<outputSize, hidden2Size>(wHid2, bHid2, toHid2, dOut, &dHid2, actFuncDeriv, eta);
-    backward_layer<hidden2Size, hidden1Size>(wHid1, bHid1, toHid1, dHid2, &dHid1, actFuncDeriv, eta);
-    backward_layer<hidden1Size, inputSize>(wIn, bIn, inputData, dHid1, 0, 0, eta);
+  void backward(const FP *inputData, const FP *targetData) {
+    with_activation([&](auto A) { backward_impl<decltype(A)::value>(inputData, targetData); });
     if (debug) {
       std::cout << "==== Weight ====" << std::endl;
-#define debugWeight(in, out, wname)                                 \
-  for (int i = 0; i < in; ++i) {                                    \
-    for (int j = 0; j < out; ++j) std::cout << wname[i][j] << "\t"; \
-    std::cout << std::endl;                                         \
-  }                                                                 \
+#define debugWeight(in, out, layer)                                       \
+  for (size_t i = 0; i < in; ++i) {                                       \
+    for (size_t j = 0; j < out; ++j) std::cout << layer.at(i, j) << "\t"; \
+    std::cout << std::endl;                                               \
+  }                                                                       \
   std::cout << std::endl;
 
       std::cout << std::fixed << std::setprecision(12);
-      debugWeight(inputSize, hidden1Size, wIn);
-      debugWeight(hidden1Size, hidden2Size, wHid1);
-      debugWeight(hidden2Size, outputSize, wHid2);
+      debugWeight(inputSize, hidden1Size, lIn);
+      debugWeight(hidden1Size, hidden2Size, lHid1);
+      debugWeight(hidden2Size, outputSize, lHid2);
 
       std::cout << "==== Bias ====" << std::endl;
 #define debugBias(bname, size)                                     \
   for (size_t i = 0; i < size; ++i) std::cout << bname[i] << "\t"; \
   std::cout << std::endl;
 
-      debugBias(bIn, hidden1Size);
-      debugBias(bHid1, hidden2Size);
-      debugBias(bHid2, outputSize);
+      debugBias(lIn.b, hidden1Size);
+      debugBias(lHid1.b, hidden2Size);
+      debugBias(lHid2.b, outputSize);
 
       debugBias(dHid1, hidden1Size);
       debugBias(dHid2, hidden2Size);
@@ -313,8 +468,42 @@ class BasicFFN {
     }
   }
 
+  /* mini-batch: X batch × inputSize dan Y batch × outputSize, keduanya row-major.
+   * Gradien dirata-rata lalu bobot diupdate sekali, get_loss() jadi rata-rata loss batch.
+   */
+  void train_batch(const FP *X, const FP *Y, size_t batch) {
+    if (!batch) return;
+    with_activation([&](auto A) { train_batch_impl<decltype(A)::value>(X, Y, batch); });
+  }
+
+  // inference satu batch: X batch × inputSize, Y batch × outputSize, row-major
+  void forward_batch(const FP *X, FP *Y, size_t batch) {
+    if (!batch) return;
+    const Linear::MatrixView<const FP> Xv(X, batch, inputSize, inputSize, 1);
+    with_activation([&](auto A) { forward_batch_impl<decltype(A)::value>(Xv, batch); });
+    for (size_t r = 0; r < batch; ++r) std::copy_n(bOut.row(r).data(), outputSize, Y + r * outputSize);
+  }
+
   FP get_loss() { return lastLoss; }
 
+  // waktu forward/backward per layer untuk train_batch/forward_batch, dijumlah sampai reset_timings()
+  void set_profiling(bool on) { prof.enable(3, on); }
+  void reset_timings() { prof.reset(); }
+  const std::vector<LayerTiming> &layer_timings() const { return prof.timings(); }
+
+  // export bobot terlatih ke model inference int8, layer input tetap tanpa aktivasi
+  quant::QuantizedFFN<FP> quantize() const {
+    // ReLU membawa epsilon instance ini, bukan nilai global
+    typename quant::QuantizedFFN<FP>::Activation act = [eps = epsilon](FP x) { return x > 0 ? x : eps; };
+    if (act_t == SIGMOID) act = precise ? &sigmoid<true> : &sigmoid<false>;
+    else if (act_t == TANH) act = precise ? &tanh<true> : &tanh<false>;
+    quant::QuantizedFFN<FP> q;
+    q.add_layer(lIn.view(), lIn.b.data(), nullptr);
+    q.add_layer(lHid1.view(), lHid1.b.data(), act);
+    q.add_layer(lHid2.view(), lHid2.b.data(), act);
+    return q;
+  }
+
   void set_debug_mode(bool debug) { this->debug = debug; }
 
   void set_weights_filename(const std::string &filename) {
@@ -328,13 +517,46 @@ class BasicFFN {
       std::cerr << "Failed to open file for saving: " << weights_filename << "\n";
       return;
     }
-    write_matrix(ofs, wIn, inputSize, hidden1Size);
-    write_matrix(ofs, wHid1, hidden1Size, hidden2Size);
-    write_matrix(ofs, wHid2, hidden2Size, outputSize);
+    write_matrix(ofs, lIn);
+    write_matrix(ofs, lHid1);
+    write_matrix(ofs, lHid2);
 
-    ofs.write(reinterpret_cast<char *>(bIn), sizeof(FP) * hidden1Size);
-    ofs.write(reinterpret_cast<char *>(bHid1), sizeof(FP) * hidden2Size);
-    ofs.write(reinterpret_cast<char *>(bHid2), sizeof(FP) * outputSize);
+    ofs.write(reinterpret_cast<char *>(lIn.b.data()), sizeof(FP) * hidden1Size);
+    ofs.write(reinterpret_cast<char *>(lHid1.b.data()), sizeof(FP) * hidden2Size);
+    ofs.write(reinterpret_cast<char *>(lHid2.b.data()), sizeof(FP) * outputSize);
+  }
+
+  /* Simpan ke format model bersama (nn_model_file.hxx): header, shape, aktivasi,
+   * dtype dan checksum. Beda dengan save_weights, file ini bisa di-mmap.
+   */
+  void save_model(const std::string &path) const {
+    model::ModelWriter<FP> wr(epsilon);
+    wr.add_layer(lIn.view(), lIn.b.data(), model::ACT_NONE);
+    wr.add_layer(lHid1.view(), lHid1.b.data(), model_activation());
+    wr.add_layer(lHid2.view(), lHid2.b.data(), model_activation());
+    wr.save(path);
+  }
+
+  // shape file harus sama dengan parameter template, aktivasi dan epsilon ikut file
+  void load_model(const std::string &path) {
+    const model::MappedModel<FP> m(path);
+    const size_t                 shape[4] = {inputSize, hidden1Size, hidden2Size, outputSize};
+    if (m.layers() != 3) throw std::runtime_error("BasicFFN: model must have exactly 3 layers");
+    for (size_t l = 0; l < 3; ++l)
+      if (m.layer(l).in != shape[l] || m.layer(l).out != shape[l + 1]) throw std::runtime_error("BasicFFN: model shape doesn't match template sizes");
+
+    // BasicFFN cuma punya satu act_t: layer input tanpa aktivasi, dua layer sisanya harus sama
+    const uint32_t act = m.layer(1).activation;
+    if (m.layer(0).activation != model::ACT_NONE || m.layer(2).activation != act ||
+        (act != model::ACT_RELU && act != model::ACT_SIGMOID && act != model::ACT_TANH))
+      throw std::runtime_error("BasicFFN: model activations don't fit BasicFFN");
+    act_t   = act == model::ACT_SIGMOID ? SIGMOID : act == model::ACT_TANH ? TANH : RELU;
+    epsilon = m.relu_epsilon();
+    copy_layer(m, 0, lIn);
+    copy_layer(m, 1, lHid1);
+    copy_layer(m, 2, lHid2);
+    // momen Adam milik bobot lama tidak berlaku untuk bobot baru
+    if (opt) opt->reset();
   }
 
   void load_weights() {
@@ -346,28 +568,14 @@ class BasicFFN {
       return;
     }
 
-    read_matrix(ifs, wIn, inputSize, hidden1Size);
-    read_matrix(ifs, wHid1, hidden1Size, hidden2Size);
-    read_matrix(ifs, wHid2, hidden2Size, outputSize);
-
-    ifs.read(reinterpret_cast<char *>(bIn), sizeof(FP) * hidden1Size);
-    ifs.read(reinterpret_cast<char *>(bHid1), sizeof(FP) * hidden2Size);
-    ifs.read(reinterpret_cast<char *>(bHid2), sizeof(FP) * outputSize);
-  }
-
-  ~BasicFFN() {
-    deallocate_2d(wIn, inputSize);
-    deallocate_2d(wHid1, hidden1Size);
-    deallocate_2d(wHid2, hidden2Size);
-    delete[] bIn;
-    delete[] bHid1;
-    delete[] bHid2;
-    delete[] toHid1;
-    delete[] toHid2;
-    delete[] out;
-    delete[] dHid1;
-    delete[] dHid2;
-    delete[] dOut;
+    read_matrix(ifs, lIn);
+    read_matrix(ifs, lHid1);
+    read_matrix(ifs, lHid2);
+
+    ifs.read(reinterpret_cast<char *>(lIn.b.data()), sizeof(FP) * hidden1Size);
+    ifs.read(reinterpret_cast<char *>(lHid1.b.data()), sizeof(FP) * hidden2Size);
+    ifs.read(reinterpret_cast<char *>(lHid2.b.data()), sizeof(FP) * outputSize);
+    if (opt) opt->reset();
   }
 };
 
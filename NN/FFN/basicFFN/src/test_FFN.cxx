@@ -0,0 +1,178 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <ffn.hxx>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/* Bobot awal ditulis sendiri (format save_weights, seed tetap) karena init_wb() diseed
+ * dari random_device. Urutan cek:
+ *  - forward() dibandingkan dengan perhitungan naif dari bobot yang sama
+ *  - backward() beberapa langkah lalu save_weights/load_weights harus identik
+ *  - train_batch dengan AdamW harus turun ke loss kecil
+ *  - save_model → load_model ke instance baru harus identik, epsilon tidak bocor antar instance
+ *  - quantize() dalam toleransi, file dengan aktivasi campur harus ditolak
+ */
+namespace {
+constexpr size_t In = 1, H1 = 16, H2 = 16, Out = 1;
+using Net = NN::BasicFFN<double, In, H1, H2, Out>;
+
+struct Dense {
+  size_t              in, out;
+  std::vector<double> w, b;  // w out × in
+};
+
+// y = act(W x + b), act kosong = tanpa aktivasi
+std::vector<double> dense(const Dense &l, const std::vector<double> &x, bool act) {
+  std::vector<double> y(l.out);
+  for (size_t o = 0; o < l.out; ++o) {
+    double z = l.b[o];
+    for (size_t i = 0; i < l.in; ++i) z += l.w[o * l.in + i] * x[i];
+    y[o] = act ? std::tanh(z) : z;
+  }
+  return y;
+}
+
+// format save_weights: per baris input semua bobot ke output, lalu semua bias
+void write_legacy(const std::string &path, const Dense (&ls)[3]) {
+  std::ofstream ofs(path, std::ios::binary);
+  for (const auto &l : ls)
+    for (size_t i = 0; i < l.in; ++i)
+      for (size_t o = 0; o < l.out; ++o) ofs.write(reinterpret_cast<const char *>(&l.w[o * l.in + i]), sizeof(double));
+  for (const auto &l : ls) ofs.write(reinterpret_cast<const char *>(l.b.data()), sizeof(double) * l.out);
+}
+}  // namespace
+
+int main() {
+  using namespace NN;
+  constexpr size_t batch = 64, steps = 3000;
+
+  std::vector<double> X(batch), Y(batch);
+  for (size_t i = 0; i < batch; ++i) {
+    X[i] = -M_PI + 2 * M_PI * double(i) / double(batch - 1);
+    Y[i] = std::sin(X[i]);
+  }
+
+  const auto dir         = std::filesystem::temp_directory_path();
+  const auto initPath    = (dir / "test_basicFFN_init.bin").string();
+  const auto weightsPath = (dir / "test_basicFFN_weights.bin").string();
+  const auto modelPath   = (dir / "test_basicFFN.nnm").string();
+  const auto epsPath     = (dir / "test_basicFFN_eps.nnm").string();
+  const auto badPath     = (dir / "test_basicFFN_bad.nnm").string();
+
+  // He init seperti init_wb(), bias kecil supaya ikut teruji
+  std::mt19937 gen(42);
+  auto         layer = [&](size_t in, size_t out) {
+    std::normal_distribution<double>       dis(0, std::sqrt(2.0 / double(in)));
+    std::uniform_real_distribution<double> bias(-0.1, 0.1);
+    Dense                                  l{in, out, std::vector<double>(out * in), std::vector<double>(out)};
+    for (auto &x : l.w) x = dis(gen);
+    for (auto &x : l.b) x = bias(gen);
+    return l;
+  };
+  const Dense init[3] = {layer(In, H1), layer(H1, H2), layer(H2, Out)};
+  write_legacy(initPath, init);
+
+  Net ffn(TANH, MSE, initPath);
+  ffn.set_precise_activation(true);
+
+  // layer input tanpa aktivasi, dua layer sisanya tanh
+  double maxRefDiff = 0;
+  for (double x : X) {
+    const auto ref = dense(init[2], dense(init[1], dense(init[0], {x}, false), true), true);
+    maxRefDiff     = std::max(maxRefDiff, std::abs(ffn.forward(&x)[0] - ref[0]));
+  }
+  ffn.set_precise_activation(false);
+
+  // SGD per sampel lalu simpan/muat ulang format lama
+  for (size_t i = 0; i < batch; ++i) ffn.backward(&X[i], &Y[i]);
+  std::filesystem::remove(weightsPath);  // set_weights_filename() memuat file yang sudah ada
+  ffn.set_weights_filename(weightsPath);
+  ffn.save_weights();
+  Net    reloaded(TANH, MSE, weightsPath);
+  double maxWeightsDiff = 0;
+  for (double x : X) maxWeightsDiff = std::max(maxWeightsDiff, std::abs(ffn.forward(&x)[0] - reloaded.forward(&x)[0]));
+
+  OptimizerConfig<double> cfg;
+  cfg.type        = OPT_ADAMW;
+  cfg.lr          = 1e-2;
+  cfg.weightDecay = 1e-4;
+  ffn.set_optimizer(cfg);
+  for (size_t s = 0; s < steps; ++s) ffn.train_batch(X.data(), Y.data(), batch);
+  const double loss = ffn.get_loss();
+
+  ffn.save_model(modelPath);
+  Net loaded;  // aktivasi default ReLU, harus ditimpa dari file
+  loaded.load_model(modelPath);
+
+  double              maxLoadDiff = 0;
+  std::vector<double> out(batch), outLoaded(batch), outQ(batch);
+  ffn.forward_batch(X.data(), out.data(), batch);
+  loaded.forward_batch(X.data(), outLoaded.data(), batch);
+  for (size_t i = 0; i < batch; ++i) maxLoadDiff = std::max(maxLoadDiff, std::abs(out[i] - outLoaded[i]));
+
+  // epsilon dari file cuma milik instance yang memuatnya
+  {
+    Net relu;
+    relu.set_epsilon(1e-3);
+    relu.save_model(epsPath);
+    Net other;
+    other.load_model(epsPath);
+  }
+  ffn.save_model(modelPath);
+  const bool epsIsolated = model::MappedModel<double>(modelPath).relu_epsilon() == 1e-6;
+
+  // aktivasi int8 cuma 7 bit, selisih ~0.1 dari model float masih wajar
+  const auto q        = loaded.quantize();
+  double     maxQDiff = 0;
+  q.forward_batch(X.data(), outQ.data(), batch);
+  for (size_t i = 0; i < batch; ++i) maxQDiff = std::max(maxQDiff, std::abs(out[i] - outQ[i]));
+
+  // aktivasi layer 2 beda dengan layer 1 → BasicFFN tidak bisa merepresentasikan
+  bool rejected = false;
+  {
+    model::ModelWriter<double> wr;
+    wr.add_layer(Linear::MatrixView<const double>(init[0].w.data(), H1, In, In, 1), init[0].b.data(), model::ACT_NONE);
+    wr.add_layer(Linear::MatrixView<const double>(init[1].w.data(), H2, H1, H1, 1), init[1].b.data(), model::ACT_TANH);
+    wr.add_layer(Linear::MatrixView<const double>(init[2].w.data(), Out, H2, H2, 1), init[2].b.data(), model::ACT_SIGMOID);
+    wr.save(badPath);
+    try {
+      Net bad;
+      bad.load_model(badPath);
+    } catch (const std::runtime_error &) {
+      rejected = true;
+    }
+  }
+  for (const auto &path : {initPath, weightsPath, modelPath, epsPath, badPath}) std::filesystem::remove(path);
+
+  std::cout << "max |forward - reference|  = " << maxRefDiff << "\n"
+            << "max |forward - reloaded|   = " << maxWeightsDiff << "\n"
+            << "loss after " << steps << " Adam steps = " << loss << "\n"
+            << "max |forward - loaded|     = " << maxLoadDiff << "\n"
+            << "epsilon isolated           = " << std::boolalpha << epsIsolated << "\n"
+            << "max |forward - quantized|  = " << maxQDiff << "\n"
+            << "mixed activations rejected = " << rejected << std::endl;
+  const bool ok = maxRefDiff < 1e-12 && maxWeightsDiff == 0 && loss < 1e-2 && maxLoadDiff == 0 && epsIsolated && maxQDiff < 0.15 && rejected;
+  return ok ? 0 : 1;
+}
@@ -19,49 +19,102 @@
 
 
 #pragma once
-#include <omp.h>
 
+#include <aligned.hxx>
+#include <algorithm>
+#include <dense_matrix.hxx>
+#include <gemm.hxx>
+#include <nn_dataset.hxx>
+#include <nn_kernels.hxx>
+#include <nn_model_file.hxx>
 #include <nn_objects.hxx>
+#include <nn_optimizer.hxx>
+#include <nn_profile.hxx>
+#include <nn_quant.hxx>
+#include <optional>
 #include <random>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace NN {
 
+/* FFN sekuensial dengan kedalaman dan lebar bebas, dideskripsikan oleh Layer<FP>:
+ * layers[0] = ukuran input (aktivasinya diabaikan), layers[1..] = layer berikutnya.
+ * Tiap langkah dikerjakan per layer untuk satu batch sekaligus: gemm lalu epilogue
+ * bias + aktivasi yang digabung dalam satu pass, paralelnya lewat tim OpenMP yang
+ * sama (thread pool bawaan runtime) jadi tidak ada thread baru per langkah.
+ */
 template <std::floating_point FP>
 class FFN {
-  std::vector<std::vector<FP>> win, wh1, wh2;
-  std::vector<FP>              bin, bh1, bh2;
-  ACTIVATION_TYPE              act_s[3];
-  LOSS_TYPE                    loss_t;
-
-  inline static FP epsilon = FP(1e-6);
-  FP               eta     = FP(1e-2);
-  FP               loss_   = FP(0);
+  // bobot yang menghubungkan layers[l] ke layers[l + 1], w berukuran in × out row-major
+  struct Params {
+    Linear::Matrix<FP>         w;
+    Linear::aligned_vector<FP> b;
+    // gradien dan id tensor di optimizer, cuma dipakai kalau set_optimizer() dipanggil
+    Linear::Matrix<FP>         gw;
+    Linear::aligned_vector<FP> gb;
+    size_t                     wId = 0, bId = 0;
+  };
+
+  std::vector<Layer<FP>> layers;
+  std::vector<Params>    params;
+  LOSS_TYPE              loss_t;
+  // kosong = SGD biasa yang digabung ke gemm, tanpa buffer gradien
+  std::optional<Optimizer<FP>> opt;
+  LayerProfiler                prof;
+
+  FP   epsilon = FP(1e-6);  // per instance, ikut file model saat dimuat
+  FP   eta     = FP(1e-2);
+  FP   loss_   = FP(0);
+  bool precise = false;  // true = std::exp/std::tanh, false = pendekatan cepat
 
   std::random_device           dev;
   std::mt19937_64              gen;
   std::normal_distribution<FP> dis;
 
-  static inline FP activate(FP x, ACTIVATION_TYPE t) {
-    switch (t) {
-      case ACTIVATION_TYPE::ReLU: return ReLU<FP>(x, epsilon);
-      case ACTIVATION_TYPE::sigmoid: return sigmoid<FP>(x);
-      case ACTIVATION_TYPE::tanh: return tanh<FP>(x);
-      case ACTIVATION_TYPE::NONE: return x;
-    }
-    return x;
+  /* Arena aktivasi: A_l (batch × ld_l) untuk semua layer dan delta D_l untuk layer
+   * 1..L ada di satu buffer rata cache line, tiap baris juga dipad ke cache line.
+   * Offset direncanakan ulang tiap batch, buffer cuma tumbuh kalau batch lebih besar
+   * dari sebelumnya, jadi training dengan ukuran batch tetap tidak alokasi sama sekali.
+   */
+  Linear::aligned_vector<FP> arena;
+  std::vector<size_t>        ld, actOffset, deltaOffset;
+  size_t                     batch_ = 0;
+
+  // epilogue di bawah ini baru diparalelkan kalau elemennya cukup banyak
+  static constexpr size_t PARALLEL_MIN = 1 << 14;
+
+  /* Precise sama artinya dengan member precise: std::exp/std::tanh alih-alih pendekatan cepat.
+   * eps dioper eksplisit supaya fungsi aktivasi hasil quantize() tidak bergantung ke instance
+   */
+  template <ACTIVATION_TYPE A, bool Precise = false>
+  static inline FP activate(FP x, FP eps) {
+    if constexpr (A == ACTIVATION_TYPE::ReLU) return ReLU<FP>(x, eps);
+    else if constexpr (A == ACTIVATION_TYPE::sigmoid) return Precise ? sigmoid(x) : kernel::fast_sigmoid(x);
+    else if constexpr (A == ACTIVATION_TYPE::tanh) return Precise ? std::tanh(x) : kernel::fast_tanh(x);
+    else return x;
+  }
+  template <ACTIVATION_TYPE A>
+  static inline FP d_activate(FP y, FP eps) {
+    if constexpr (A == ACTIVATION_TYPE::ReLU) return ReLU_deriv<FP>(y, eps);
+    else if constexpr (A == ACTIVATION_TYPE::sigmoid) return Sigmoid_deriv<FP>(y);
+    else if constexpr (A == ACTIVATION_TYPE::tanh) return tanh_deriv<FP>(y);
+    else return FP(1);
   }
-  static inline FP d_activate(FP y, ACTIVATION_TYPE t) {
+
+  // switch sekali per layer, f dipanggil dengan std::integral_constant<ACTIVATION_TYPE, ...>
+  template <typename F>
+  static void with_activation(ACTIVATION_TYPE t, F&& f) {
     switch (t) {
-      case ACTIVATION_TYPE::ReLU: return d_ReLU<FP>(y, epsilon);
-      case ACTIVATION_TYPE::sigmoid: return d_sigmoid<FP>(y);
-      case ACTIVATION_TYPE::tanh: return d_tanh<FP>(y);
-      case ACTIVATION_TYPE::NONE: return FP(1);
+      case ACTIVATION_TYPE::ReLU: return f(std::integral_constant<ACTIVATION_TYPE, ACTIVATION_TYPE::ReLU>{});
+      case ACTIVATION_TYPE::sigmoid: return f(std::integral_constant<ACTIVATION_TYPE, ACTIVATION_TYPE::sigmoid>{});
+      case ACTIVATION_TYPE::tanh: return f(std::integral_constant<ACTIVATION_TYPE, ACTIVATION_TYPE::tanh>{});
+      case ACTIVATION_TYPE::NONE: return f(std::integral_constant<ACTIVATION_TYPE, ACTIVATION_TYPE::NONE>{});
     }
-    return FP(1);
   }
 
-  static inline FP loss(LOSS_TYPE lt, FP y_hat, FP y) {
+  inline FP loss(LOSS_TYPE lt, FP y_hat, FP y) const {
     switch (lt) {
       case LOSS_TYPE::MAE: return MAE<FP>(y_hat, y);
       case LOSS_TYPE::MSE: return MSE<FP>(y_hat, y);
@@ -69,179 +122,293 @@ class FFN {
     }
     return FP(0);
   }
-  static inline FP d_loss(LOSS_TYPE lt, FP y_hat, FP y, FP eps) {
+  inline FP d_loss(LOSS_TYPE lt, FP y_hat, FP y) const {
     switch (lt) {
-      case LOSS_TYPE::MAE: return d_MAE<FP>(y_hat, y);
-      case LOSS_TYPE::MSE: return d_MSE<FP>(y_hat, y);
-      case LOSS_TYPE::cross_entropy: return d_cross_entropy<FP>(y_hat, y, eps);
+      case LOSS_TYPE::MAE: return MAE_deriv<FP>(y_hat, y);
+      case LOSS_TYPE::MSE: return MSE_deriv<FP>(y_hat, y);
+      case LOSS_TYPE::cross_entropy: return cross_entropy_deriv<FP>(y_hat, y, epsilon);
     }
     return FP(0);
   }
 
-  std::vector<FP> forward(const std::vector<FP>& input) {
-    std::vector<FP> h1(wh1.size());
-#pragma omp parallel for
-    for (size_t j = 0; j < wh1.size(); ++j) {
-      FP z = bin[j];
-      for (size_t i = 0; i < input.size(); ++i) z += input[i] * win[i][j];
-      h1[j] = activate(z, act_s[0], epsilon);
-    }
+  size_t depth() const { return params.size(); }
 
-    std::vector<FP> h2(wh2.size());
-#pragma omp parallel for
-    for (size_t j = 0; j < wh2.size(); ++j) {
-      FP z = bh1[j];
-      for (size_t i = 0; i < h1.size(); ++i) z += h1[i] * wh1[i][j];
-      h2[j] = activate(z, act_s[1], epsilon);
+  void plan_arena(size_t batch) {
+    batch_        = batch;
+    size_t offset = 0;
+    for (size_t l = 0; l < layers.size(); ++l) {
+      actOffset[l]  = offset;
+      offset       += batch * ld[l];
     }
-
-    std::vector<FP> out(bh2.size());
-#pragma omp parallel for
-    for (size_t j = 0; j < out.size(); ++j) {
-      FP z = bh2[j];
-      for (size_t i = 0; i < h2.size(); ++i) z += h2[i] * wh2[i][j];
-      out[j] = activate(z, act_s[2], epsilon);
+    for (size_t l = 1; l < layers.size(); ++l) {
+      deltaOffset[l]  = offset;
+      offset         += batch * ld[l];
     }
-
-    return out;
+    if (arena.size() < offset) arena.resize(offset);
   }
 
-  void backward(const std::vector<std::vector<FP>>& inputs, const std::vector<std::vector<FP>>& targets) {
-    const size_t B = inputs.size();
-    if (B == 0) return;
-
-    std::vector<std::vector<FP>> gWin(win.size(), std::vector<FP>(win[0].size(), FP(0)));
-    std::vector<std::vector<FP>> gWh1(wh1.size(), std::vector<FP>(wh1[0].size(), FP(0)));
-    std::vector<std::vector<FP>> gWh2(wh2.size(), std::vector<FP>(wh2[0].size(), FP(0)));
-    std::vector<FP>              gBin(bin.size(), FP(0)), gBh1(bh1.size(), FP(0)), gBh2(bh2.size(), FP(0));
-
-    FP loss_sum = FP(0);
-
-#pragma omp parallel for reduction(+ : loss_sum)
-    for (size_t b = 0; b < B; ++b) {
-      const auto& input  = inputs[b];
-      const auto& target = targets[b];
-
-      std::vector<FP> h1(wh1.size());
-      for (size_t j = 0; j < wh1.size(); ++j) {
-        FP z = bin[j];
-        for (size_t i = 0; i < input.size(); ++i) z += input[i] * win[i][j];
-        h1[j] = activate(z, act_s[0], epsilon);
-      }
-
-      std::vector<FP> h2(wh2.size());
-      for (size_t j = 0; j < wh2.size(); ++j) {
-        FP z = bh1[j];
-        for (size_t i = 0; i < h1.size(); ++i) z += h1[i] * wh1[i][j];
-        h2[j] = activate(z, act_s[1], epsilon);
-      }
-
-      std::vector<FP> out(bh2.size());
-      for (size_t j = 0; j < out.size(); ++j) {
-        FP z = bh2[j];
-        for (size_t i = 0; i < h2.size(); ++i) z += h2[i] * wh2[i][j];
-        out[j] = activate(z, act_s[2], epsilon);
-      }
-
-      FP l = FP(0);
-      for (size_t i = 0; i < out.size(); ++i) l += loss(loss_t, out[i], target[i], epsilon);
-      loss_sum += l;
+  Linear::MatrixView<FP> act(size_t l) { return Linear::MatrixView<FP>(arena.data() + actOffset[l], batch_, layers[l].size, ld[l], 1); }
+  Linear::MatrixView<FP> delta(size_t l) { return Linear::MatrixView<FP>(arena.data() + deltaOffset[l], batch_, layers[l].size, ld[l], 1); }
+
+  // Z = act(Z + b), per baris setelah gemm: bias lalu kernel aktivasi selagi barisnya masih di L1
+  void bias_activate(Linear::MatrixView<FP> Z, const FP* b, ACTIVATION_TYPE t) const {
+    const size_t n = Z.cols();
+#pragma omp parallel for schedule(static) if (Z.rows() * n >= PARALLEL_MIN)
+    for (size_t r = 0; r < Z.rows(); ++r) {
+      FP* z = Z.row(r).data();
+#pragma omp simd
+      for (size_t i = 0; i < n; ++i) z[i] += b[i];
+      apply_activation(Z.row(r), t, epsilon, precise);
+    }
+  }
 
-      std::vector<FP> delta_out(out.size());
-      for (size_t i = 0; i < out.size(); ++i) {
-        FP dL        = d_loss(loss_t, out[i], target[i], epsilon);
-        FP dact      = d_activate(out[i], act_s[2], epsilon);
-        delta_out[i] = dL * dact;
-      }
+  // D ⊙= act'(H)
+  void mul_deriv(Linear::MatrixView<FP> D, Linear::MatrixView<FP> H, ACTIVATION_TYPE t) {
+    if (t == ACTIVATION_TYPE::NONE) return;
+#pragma omp parallel for schedule(static) if (D.rows() * D.cols() >= PARALLEL_MIN)
+    for (size_t r = 0; r < D.rows(); ++r) apply_activation_deriv<FP>(D.row(r), H.row(r), t, epsilon);
+  }
 
-      std::vector<FP> delta_h2(h2.size(), FP(0));
-      for (size_t i = 0; i < h2.size(); ++i) {
-        for (size_t j = 0; j < out.size(); ++j) delta_h2[i] += wh2[i][j] * delta_out[j];
-        delta_h2[i] *= d_activate(h2[i], act_s[1], epsilon);
-      }
+  void forward() {
+    for (size_t l = 0; l < depth(); ++l)
+      prof.time_forward(l, [&] {
+        Linear::gemm<FP>(1, act(l), params[l].w, 0, act(l + 1));
+        bias_activate(act(l + 1), params[l].b.data(), layers[l + 1].act_func_t);
+      });
+  }
 
-      std::vector<FP> delta_h1(h1.size(), FP(0));
-      for (size_t i = 0; i < h1.size(); ++i) {
-        for (size_t j = 0; j < h2.size(); ++j) delta_h1[i] += wh1[i][j] * delta_h2[j];
-        delta_h1[i] *= d_activate(h1[i], act_s[0], epsilon);
-      }
+  // delta layer output sekaligus loss, y(r, i) = target sampel r output i
+  template <typename Target>
+  void output_delta(Target&& y) {
+    const size_t L = depth(), n = layers[L].size;
+    auto         O = act(L), D = delta(L);
+    FP           l = 0;
+    with_activation(layers[L].act_func_t, [&](auto A) {
+#pragma omp parallel for reduction(+ : l) schedule(static) if (batch_ * n >= PARALLEL_MIN)
+      for (size_t r = 0; r < batch_; ++r)
+        for (size_t i = 0; i < n; ++i) {
+          const FP o = O(r, i), t = y(r, i);
+          l       += loss(loss_t, o, t);
+          D(r, i)  = d_loss(loss_t, o, t) * d_activate<decltype(A)::value>(o, epsilon);
+        }
+    });
+    loss_ = l / batch_;
+  }
 
-      for (size_t i = 0; i < win.size(); ++i)
-        for (size_t j = 0; j < win[0].size(); ++j) gWin[i][j] += input[i] * delta_h1[j];
+  /* Mundur per layer. D_{l} dihitung dulu dengan bobot lama, baru bobot layer l
+   * diupdate. Tanpa optimizer update SGD langsung lewat gemm (W -= scale · A_lᵀ · D_{l+1})
+   * jadi tidak perlu buffer gradien; dengan optimizer gradiennya ditulis ke gw/gb lalu
+   * satu pass fused per tensor. Tiap elemen C gemm dimiliki satu thread, hasilnya
+   * tetap deterministik.
+   */
+  void backward() {
+    const FP scale = eta / batch_, invB = FP(1) / batch_;
+    if (opt) opt->begin_step();
+    for (size_t l = depth(); l-- > 0;) prof.time_backward(l, [&] { backward_layer(l, scale, invB); });
+  }
 
-      for (size_t j = 0; j < gBin.size(); ++j) gBin[j] += delta_h1[j];
+  void backward_layer(size_t l, FP scale, FP invB) {
+    if (l > 0) {
+      Linear::gemm<FP>(1, delta(l + 1), params[l].w.transposed(), 0, delta(l));
+      mul_deriv(delta(l), act(l), layers[l].act_func_t);
+    }
+    Params& p = params[l];
+    auto    D = delta(l + 1);
+    if (!opt) {
+      Linear::gemm<FP>(-scale, act(l).transposed(), D, 1, p.w);
+      for (size_t r = 0; r < batch_; ++r) kernel::axpy(-scale, D.row(r).data(), p.b.data(), D.cols());
+      return;
+    }
+    Linear::gemm<FP>(1, act(l).transposed(), D, 0, p.gw);
+    std::fill(p.gb.begin(), p.gb.end(), FP(0));
+    for (size_t r = 0; r < batch_; ++r) kernel::axpy(FP(1), D.row(r).data(), p.gb.data(), D.cols());
+    opt->update(p.wId, p.w.data(), p.gw.data(), invB);
+    opt->update(p.bId, p.b.data(), p.gb.data(), invB);
+  }
 
-      for (size_t i = 0; i < wh1.size(); ++i)
-        for (size_t j = 0; j < wh1[0].size(); ++j) gWh1[i][j] += h1[i] * delta_h2[j];
+  static model::MODEL_ACTIVATION to_model(ACTIVATION_TYPE t) {
+    switch (t) {
+      case ACTIVATION_TYPE::ReLU: return model::ACT_RELU;
+      case ACTIVATION_TYPE::sigmoid: return model::ACT_SIGMOID;
+      case ACTIVATION_TYPE::tanh: return model::ACT_TANH;
+      case ACTIVATION_TYPE::NONE: return model::ACT_NONE;
+    }
+    return model::ACT_NONE;
+  }
+  static ACTIVATION_TYPE from_model(uint32_t act) {
+    switch (act) {
+      case model::ACT_RELU: return ACTIVATION_TYPE::ReLU;
+      case model::ACT_SIGMOID: return ACTIVATION_TYPE::sigmoid;
+      case model::ACT_TANH: return ACTIVATION_TYPE::tanh;
+      default: return ACTIVATION_TYPE::NONE;
+    }
+  }
+  static std::vector<Layer<FP>> layers_of(const model::MappedModel<FP>& m) {
+    if (!m.layers()) throw std::invalid_argument("FFN: model file has no layers");
+    std::vector<Layer<FP>> ls{{m.input_size(), ACTIVATION_TYPE::NONE}};
+    for (size_t l = 0; l < m.layers(); ++l) ls.push_back({m.layer(l).out, from_model(m.layer(l).activation)});
+    return ls;
+  }
 
-      for (size_t j = 0; j < gBh1.size(); ++j) gBh1[j] += delta_h2[j];
+  // He init, sequential karena generator tidak boleh dipakai bareng antar thread
+  void init_layer(Params& p, size_t in, size_t out) {
+    dis.param(typename std::normal_distribution<FP>::param_type(0, std::sqrt(FP(2) / FP(in))));
+    p.w.resize(in, out);
+    for (size_t i = 0; i < in; ++i)
+      for (size_t j = 0; j < out; ++j) p.w(i, j) = dis(gen);
+    p.b.assign(out, epsilon);
+  }
 
-      for (size_t i = 0; i < wh2.size(); ++i)
-        for (size_t j = 0; j < wh2[0].size(); ++j) gWh2[i][j] += h2[i] * delta_out[j];
+ public:
+  FFN(std::vector<Layer<FP>> layers, LOSS_TYPE lt = LOSS_TYPE::MSE) : layers(std::move(layers)), loss_t(lt) {
+    if (this->layers.size() < 2) throw std::invalid_argument("FFN: need at least an input and an output layer");
+    for (const auto& l : this->layers)
+      if (!l.size) throw std::invalid_argument("FFN: layer size must be non-zero");
+
+    gen.seed(dev());
+    params.resize(this->layers.size() - 1);
+    for (size_t l = 0; l < depth(); ++l) init_layer(params[l], this->layers[l].size, this->layers[l + 1].size);
+
+    ld.resize(this->layers.size());
+    actOffset.resize(this->layers.size());
+    deltaOffset.resize(this->layers.size());
+    for (size_t l = 0; l < this->layers.size(); ++l) ld[l] = Linear::pad_to_cache_line<FP>(this->layers[l].size);
+  }
 
-      for (size_t j = 0; j < gBh2.size(); ++j) gBh2[j] += delta_out[j];
+  // bentuk lama: 3 matriks bobot, acts[i] untuk layer ls[i + 1]
+  FFN(size_t (&ls)[4], ACTIVATION_TYPE (&acts)[3], LOSS_TYPE lt = LOSS_TYPE::MSE)
+      : FFN(std::vector<Layer<FP>>{{ls[0], ACTIVATION_TYPE::NONE}, {ls[1], acts[0]}, {ls[2], acts[1]}, {ls[3], acts[2]}}, lt) {}
+
+  /* Bobot disalin (dan ditranspose balik ke in × out) dari model yang sudah dibuka,
+   * karena training butuh buffer yang bisa ditulis. Untuk inference saja,
+   * model::MappedModel bisa langsung dipakai tanpa copy.
+   */
+  explicit FFN(const model::MappedModel<FP>& m, LOSS_TYPE lt = LOSS_TYPE::MSE) : FFN(layers_of(m), lt) {
+    epsilon = m.relu_epsilon();
+    for (size_t l = 0; l < depth(); ++l) {
+      const auto W = m.weights(l);
+      for (size_t o = 0; o < W.rows(); ++o)
+        for (size_t i = 0; i < W.cols(); ++i) params[l].w(i, o) = W(o, i);
+      std::copy_n(m.bias(l), W.rows(), params[l].b.begin());
     }
+  }
 
-    const FP invB = FP(1) / FP(B);
-
-#pragma omp parallel for
-    for (size_t i = 0; i < win.size(); ++i)
-      for (size_t j = 0; j < win[0].size(); ++j) win[i][j] -= eta * gWin[i][j] * invB;
-
-#pragma omp parallel for
-    for (size_t j = 0; j < bin.size(); ++j) bin[j] -= eta * gBin[j] * invB;
+  FP   get_loss() const { return loss_; }
+  void set_eta(FP lr) {
+    eta = lr;
+    if (opt) opt->set_lr(lr);
+  }
 
-#pragma omp parallel for
-    for (size_t i = 0; i < wh1.size(); ++i)
-      for (size_t j = 0; j < wh1[0].size(); ++j) wh1[i][j] -= eta * gWh1[i][j] * invB;
+  /* Ganti SGD bawaan dengan optimizer ber-state (momentum, Adam, AdamW).
+   * Learning rate diambil dari cfg.lr, set_eta() setelahnya ikut mengubahnya.
+   */
+  void set_optimizer(const OptimizerConfig<FP>& cfg) {
+    opt.emplace(cfg);
+    eta = cfg.lr;
+    for (auto& p : params) {
+      p.gw.resize(p.w.rows(), p.w.cols());
+      p.gb.assign(p.b.size(), 0);
+      p.wId = opt->add_tensor(p.w.size());
+      p.bId = opt->add_tensor(p.b.size(), false);
+    }
+  }
+  void set_epsilon(FP eps) { epsilon = eps; }
+  // aktivasi training/predict pakai std::exp/std::tanh penuh, default pendekatan cepat
+  void set_precise_activation(bool p) { precise = p; }
+  void set_loss_type(LOSS_TYPE lt) { loss_t = lt; }
 
-#pragma omp parallel for
-    for (size_t j = 0; j < bh1.size(); ++j) bh1[j] -= eta * gBh1[j] * invB;
+  size_t input_size() const { return layers.front().size; }
+  size_t output_size() const { return layers.back().size; }
+  // ukuran semua layer termasuk input, dipakai benchmark untuk menghitung FLOP per layer
+  const std::vector<Layer<FP>>& get_layers() const { return layers; }
+
+  /* Catat waktu forward/backward per layer (index l = bobot layers[l] → layers[l + 1]).
+   * Waktu dijumlah sampai reset_timings() atau set_profiling(true) berikutnya.
+   */
+  void set_profiling(bool on) { prof.enable(depth(), on); }
+  void reset_timings() { prof.reset(); }
+  const std::vector<LayerTiming>& layer_timings() const { return prof.timings(); }
+
+  /* mini-batch: X batch × input_size() dan Y batch × output_size(), keduanya row-major.
+   * Gradien dirata-rata lalu bobot diupdate sekali, get_loss() jadi rata-rata loss batch.
+   */
+  void train_batch(const FP* X, const FP* Y, size_t batch) {
+    if (!batch) return;
+    plan_arena(batch);
+    auto A0 = act(0);
+    for (size_t r = 0; r < batch; ++r) std::copy_n(X + r * input_size(), input_size(), A0.row(r).data());
+    forward();
+    output_delta([&](size_t r, size_t i) { return Y[r * output_size() + i]; });
+    backward();
+  }
 
-#pragma omp parallel for
-    for (size_t i = 0; i < wh2.size(); ++i)
-      for (size_t j = 0; j < wh2[0].size(); ++j) wh2[i][j] -= eta * gWh2[i][j] * invB;
+  void train_batch(const std::vector<std::vector<FP>>& X, const std::vector<std::vector<FP>>& Y) {
+    if (X.empty()) return;
+    plan_arena(X.size());
+    auto A0 = act(0);
+    for (size_t r = 0; r < X.size(); ++r) std::copy_n(X[r].begin(), input_size(), A0.row(r).data());
+    forward();
+    output_delta([&](size_t r, size_t i) { return Y[r][i]; });
+    backward();
+  }
 
-#pragma omp parallel for
-    for (size_t j = 0; j < bh2.size(); ++j) bh2[j] -= eta * gBh2[j] * invB;
+  // satu epoch penuh dari DatasetStream, @return rata-rata loss per batch
+  FP train_epoch(DatasetStream<FP>& ds) {
+    if (ds.input_size() != input_size() || ds.output_size() != output_size()) throw std::invalid_argument("FFN: dataset record doesn't match layer sizes");
+    FP     sum = 0;
+    size_t n   = 0;
+    while (const Batch<FP>* b = ds.next()) {
+      train_batch(b->X.data(), b->Y.data(), b->size);
+      sum += loss_;
+      ++n;
+    }
+    return n ? sum / n : FP(0);
+  }
 
-    loss_ = loss_sum * invB;
+  // simpan ke format model bersama (nn_model_file.hxx), bobot ditulis out × in
+  void save_model(const std::string& path) const {
+    model::ModelWriter<FP> wr(epsilon);
+    for (size_t l = 0; l < depth(); ++l) wr.add_layer(params[l].w.transposed(), params[l].b.data(), to_model(layers[l + 1].act_func_t));
+    wr.save(path);
   }
 
- public:
-  FFN(size_t (&ls)[4], ACTIVATION_TYPE (&acts)[3], LOSS_TYPE lt = LOSS_TYPE::MSE) : loss_t(lt) {
-    std::copy(acts, acts + 2, act_s);
-    gen.seed(dev.entropy());
-
-    dis.param({0, std::sqrt(ls[0])});
-    win.resize(ls[0], std::vector<FP>(ls[1]));
-#pragma omp parallel for
-    for (size_t i = 0; i < win.size(); ++i)
-      for (size_t j = 0; j < win[0].size(); ++j) win[i][j] = dis(gen);
-    bin.assign(ls[1], epsilon);
-
-    dis.param({0, std::sqrt(ls[1])});
-    wh1.resize(ls[1], std::vector<FP>(ls[2]));
-#pragma omp parallel for
-    for (size_t i = 0; i < wh1.size(); ++i)
-      for (size_t j = 0; j < wh1[0].size(); ++j) wh1[i][j] = dis(gen);
-    bh1.assign(ls[2], epsilon);
-
-    dis.param({0, std::sqrt(ls[2])});
-    wh2.resize(ls[2], std::vector<FP>(ls[3]));
-#pragma omp parallel for
-    for (size_t i = 0; i < wh2.size(); ++i)
-      for (size_t j = 0; j < wh2[0].size(); ++j) wh2[i][j] = dis(gen);
-    bh2.assign(ls[3], epsilon);
+  /* export bobot terlatih ke model inference int8, bobot in × out dioper sebagai view transpose;
+   * fungsi aktivasi ikut mode precise saat export, sama seperti forward float
+   */
+  quant::QuantizedFFN<FP> quantize() const {
+    quant::QuantizedFFN<FP> q;
+    for (size_t l = 0; l < depth(); ++l) {
+      typename quant::QuantizedFFN<FP>::Activation act = nullptr;
+      with_activation(layers[l + 1].act_func_t, [&](auto A) {
+        constexpr auto a = decltype(A)::value;
+        if constexpr (a != ACTIVATION_TYPE::NONE) {
+          if (precise) act = [eps = epsilon](FP x) { return activate<a, true>(x, eps); };
+          else act = [eps = epsilon](FP x) { return activate<a, false>(x, eps); };
+        }
+      });
+      q.add_layer(params[l].w.transposed(), params[l].b.data(), act);
+    }
+    return q;
   }
 
-  FP   get_loss() const { return loss_; }
-  void set_eta(FP lr) { eta = lr; }
-  void set_epsilon(FP eps) { epsilon = eps; }
-  void set_loss_type(LOSS_TYPE lt) { loss_t = lt; }
+  // inference satu batch: X batch × input_size(), Y batch × output_size(), row-major
+  void predict_batch(const FP* X, FP* Y, size_t batch) {
+    if (!batch) return;
+    plan_arena(batch);
+    auto A0 = act(0);
+    for (size_t r = 0; r < batch; ++r) std::copy_n(X + r * input_size(), input_size(), A0.row(r).data());
+    forward();
+    auto O = act(depth());
+    for (size_t r = 0; r < batch; ++r) std::copy_n(O.row(r).data(), output_size(), Y + r * output_size());
+  }
 
-  void            train_batch(const std::vector<std::vector<FP>>& X, const std::vector<std::vector<FP>>& Y) { backward(X, Y); }
-  std::vector<FP> predict(const std::vector<FP>& x) { return forward(x); }
+  std::vector<FP> predict(const std::vector<FP>& x) {
+    plan_arena(1);
+    std::copy_n(x.begin(), input_size(), act(0).row(0).data());
+    forward();
+    auto out = act(depth()).row(0);
+    return std::vector<FP>(out.begin(), out.end());
+  }
 };
 
 }  // namespace NN
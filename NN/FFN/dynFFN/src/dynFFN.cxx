@@ -18,12 +18,108 @@
 */
 
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <ffn.hxx>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
 #include <nn_objects.hxx>
+#include <random>
 
 int main() {
-  size_t              layer_sizes[] = {1, 1024, 1024, 1};
-  NN::ACTIVATION_TYPE act_funcs[]   = {NN::ACTIVATION_TYPE::NONE, NN::ACTIVATION_TYPE::ReLU, NN::ACTIVATION_TYPE::tanh};
-  NN::FFN<double>     ffn(layer_sizes, act_funcs);
-  return 0;
-}
\ No newline at end of file
+  // kedalaman bebas, layer pertama cuma ukuran input
+  std::vector<NN::Layer<double>> layers = {
+      {1, NN::ACTIVATION_TYPE::NONE}, {256, NN::ACTIVATION_TYPE::ReLU}, {256, NN::ACTIVATION_TYPE::ReLU}, {256, NN::ACTIVATION_TYPE::ReLU}, {1, NN::ACTIVATION_TYPE::tanh}};
+  NN::FFN<double> ffn(layers), sgd(layers);
+  sgd.set_eta(1e-2);
+  ffn.set_optimizer({.type = NN::OPT_ADAMW, .lr = 1e-3, .weightDecay = 1e-4});
+
+  // dataset regresi sin(x) di [0, 1] ditulis ke file, lalu dibaca streaming per batch 64
+  constexpr size_t                       records = 1 << 16, batch = 64, epochs = 2;
+  std::mt19937                           gen(42);
+  std::uniform_real_distribution<double> dis(0, 1);
+  std::vector<double>                    X(records), Y(records);
+  for (size_t i = 0; i < records; ++i) {
+    X[i] = dis(gen);
+    Y[i] = std::sin(X[i]);
+  }
+  // file kerja di direktori temp, bukan cwd
+  const auto        tmp       = std::filesystem::temp_directory_path();
+  const std::string dsPath    = (tmp / "dynFFN_sin.ds").string();
+  const std::string modelPath = (tmp / "dynFFN.nnm").string();
+  const std::string badPath   = (tmp / "dynFFN_bad.nnm").string();
+  NN::write_records(dsPath, X.data(), Y.data(), records, 1, 1);
+
+  // dataset yang sama untuk SGD biasa dan AdamW
+  NN::DatasetStream<double> ds(dsPath, 1, 1, batch), dsSgd(dsPath, 1, 1, batch);
+  auto                      start = std::chrono::steady_clock::now();
+  for (size_t epoch = 0; epoch < epochs; ++epoch) std::cout << "epoch " << epoch << "\tadamw loss " << ffn.train_epoch(ds) << std::endl;
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << epochs * ds.size() / sec << " samples/s" << std::endl;
+  for (size_t epoch = 0; epoch < epochs; ++epoch) std::cout << "epoch " << epoch << "\tsgd loss " << sgd.train_epoch(dsSgd) << std::endl;
+  std::cout << "sin(0.5) = " << std::sin(0.5) << "\tpredict = " << ffn.predict({0.5})[0] << std::endl;
+
+  // bandingkan model int8 dengan model float di grid [0, 1]
+  auto                q = ffn.quantize();
+  constexpr size_t    N = 1024;
+  std::vector<double> grid(N), outF(N), outQ(N);
+  for (size_t i = 0; i < N; ++i) {
+    grid[i] = double(i) / (N - 1);
+    outF[i] = ffn.predict({grid[i]})[0];
+  }
+  start = std::chrono::steady_clock::now();
+  q.forward_batch(grid.data(), outQ.data(), N);
+  sec            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double maxDiff = 0;
+  for (size_t i = 0; i < N; ++i) maxDiff = std::max(maxDiff, std::abs(outF[i] - outQ[i]));
+  std::cout << "int8: " << q.memory_bytes() / 1024 << " KiB, " << N / sec << " samples/s, max |float - int8| = " << maxDiff << std::endl;
+
+  // simpan lalu buka lagi lewat mmap, inference langsung dari mapping
+  ffn.save_model(modelPath);
+  start = std::chrono::steady_clock::now();
+  NN::model::MappedModel<double> mapped(modelPath);
+  sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::vector<double> outM(N);
+  mapped.forward_batch(grid.data(), outM.data(), N);
+  double mapDiff = 0;
+  for (size_t i = 0; i < N; ++i) mapDiff = std::max(mapDiff, std::abs(outF[i] - outM[i]));
+  std::cout << "mmap: open + verify " << sec * 1e3 << " ms, max |float - mapped| = " << mapDiff << std::endl;
+  if (mapDiff > 1e-9) return 1;
+
+  // header korup harus ditolak dengan exception, bukan crash saat payload dibaca
+  auto rejects = [&](const std::string &src, auto corrupt) {
+    std::ifstream     ifs(src, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    corrupt(bytes.data());
+    std::ofstream(badPath, std::ios::binary).write(bytes.data(), std::streamsize(bytes.size()));
+    try {
+      NN::model::MappedModel<double> bad(badPath);
+    } catch (const std::runtime_error &) {
+      return true;
+    }
+    return false;
+  };
+  const bool badPayload = rejects(modelPath, [](char *p) {
+    NN::model::FileHeader h;
+    std::memcpy(&h, p, sizeof(h));
+    h.payloadSize = UINT64_MAX - h.payloadOffset + 32;  // offset + size wrap ke angka kecil
+    std::memcpy(p, &h, sizeof(h));
+  });
+  const bool badLayer = rejects(modelPath, [](char *p) {
+    NN::model::LayerRecord r;
+    std::memcpy(&r, p + sizeof(NN::model::FileHeader), sizeof(r));
+    r.weightOffset = UINT64_MAX - 63;  // tetap rata 64, offset + ukuran bobot wrap
+    std::memcpy(p + sizeof(NN::model::FileHeader), &r, sizeof(r));
+  });
+  for (const auto &path : {dsPath, modelPath, badPath}) std::filesystem::remove(path);
+  std::cout << "corrupt header rejected: payload " << badPayload << ", layer " << badLayer << std::endl;
+  if (!badPayload || !badLayer) return 1;
+
+  // input 1 dimensi dikuantisasi 7 bit (step ~1/127), jadi toleransinya beberapa persen rentang output
+  return maxDiff < 5e-2 ? 0 : 1;
+}
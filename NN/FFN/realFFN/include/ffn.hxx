@@ -19,30 +19,90 @@
 
 #pragma once
 
+#include <cmath>
 #include <concepts>
 #include <nn_handler.hxx>
 #include <nn_objects.hxx>
 #include <random>
+#include <stdexcept>
 #include <vector>
 
+/* FFN inference yang dieksekusi lewat NNHandler: bobot dan aktivasi dialokasikan
+ * sekali di arena device, tiap layer jadi satu OP_DENSE di antrian device.
+ * layers[0] = ukuran input (aktivasinya diabaikan).
+ */
 namespace NN {
 template <std::floating_point FP>
 class FFN {
-  std::vector<Layer<FP>> layers;
-  std::random_device     rd;
-  NNHandler<FP>          handler;
-  std::mt19947           gen;
+  std::vector<Layer<FP>>  layers;
+  size_t                  maxBatch, batch = 0;
+  NNHandler<FP>           handler;
+  std::vector<Tensor<FP>> acts, weights, biases;
+  std::random_device      rd;
+  std::mt19937            gen;
+
+  static size_t arena_bytes(const std::vector<Layer<FP>> &layers, size_t maxBatch) {
+    if (layers.size() < 2) throw std::invalid_argument("FFN: need at least an input and an output layer");
+    size_t bytes = 0;
+    for (size_t l = 0; l < layers.size(); ++l) {
+      bytes += TensorArena::bytes_for<FP>(maxBatch, layers[l].size);
+      if (l) bytes += TensorArena::bytes_for<FP>(layers[l - 1].size, layers[l].size) + TensorArena::bytes_for<FP>(1, layers[l].size);
+    }
+    return bytes;
+  }
+
+  // antrian op dibangun ulang cuma kalau ukuran batch berubah
+  void build_queue(size_t b) {
+    auto &dev = handler.get_device();
+    dev.clear_queue();
+    for (size_t l = 0; l + 1 < layers.size(); ++l)
+      dev.enqueue({OP_DENSE, "dense" + std::to_string(l), acts[l].top_rows(b), acts[l + 1].top_rows(b), weights[l], biases[l], layers[l + 1].act_func_t});
+    batch = b;
+  }
 
  public:
-  FFN(std::vector<Layer> layers, COMPUTE_MODE mode = COMPUTE_MODE::CPU) : layers(layers) { handler = NNHandler<FP>(mode); }
-  FFN() = delete;
-  Layer<FP> forward(Layer<FP> input) {
-    for (size_t i = 0; i < layers.size(); ++i) {
-      Layer<FP> &current_layer = layers[i];
-      handler.run(input, current_layer);
-      input = current_layer;
+  FFN(std::vector<Layer<FP>> layers, size_t maxBatch = 64, COMPUTE_MODE mode = COMPUTE_MODE::CPU)
+      : layers(std::move(layers)), maxBatch(maxBatch), handler(mode, arena_bytes(this->layers, maxBatch)), gen(rd()) {
+    auto &dev = handler.get_device();
+    for (const auto &l : this->layers) acts.push_back(dev.alloc(maxBatch, l.size));
+
+    // He init di host lalu diupload ke device
+    for (size_t l = 1; l < this->layers.size(); ++l) {
+      const size_t                 in = this->layers[l - 1].size, out = this->layers[l].size;
+      std::normal_distribution<FP> dis(0, std::sqrt(FP(2) / FP(in)));
+      std::vector<FP>              w(in * out), b(out, 0);
+      for (auto &v : w) v = dis(gen);
+      weights.push_back(dev.alloc(in, out));
+      biases.push_back(dev.alloc(1, out));
+      dev.upload(weights.back(), w.data());
+      dev.upload(biases.back(), b.data());
     }
-    return input;
   }
+  FFN() = delete;
+
+  // bobot layer l (in × out row-major) dan bias dari host
+  void set_weights(size_t l, const FP *w, const FP *b) {
+    handler.get_device().upload(weights.at(l), w);
+    handler.get_device().upload(biases.at(l), b);
+  }
+  void get_weights(size_t l, FP *w, FP *b) {
+    handler.get_device().download(weights.at(l), w);
+    handler.get_device().download(biases.at(l), b);
+  }
+
+  // X batch × input row-major, @return batch × output row-major
+  std::vector<FP> forward(const FP *X, size_t b) {
+    if (!b || b > maxBatch) throw std::invalid_argument("FFN: batch must be in [1, maxBatch]");
+    if (b != batch) build_queue(b);
+    auto &dev = handler.get_device();
+    dev.upload(acts.front().top_rows(b), X);
+    handler.run();
+    std::vector<FP> out(b * layers.back().size);
+    dev.download(acts.back().top_rows(b), out.data());
+    return out;
+  }
+
+  const std::vector<OpTiming> &timings() const { return handler.timings(); }
+  NNHandler<FP>               &get_handler() { return handler; }
 };
-}  // namespace NN
\ No newline at end of file
+}  // namespace NN
@@ -18,9 +18,46 @@
 */
 
 
+#include <algorithm>
+#include <cmath>
 #include <ffn.hxx>
+#include <iostream>
+#include <vector>
 
+// bandingkan hasil backend CPU dengan perhitungan naif di host, tanpa GPU/Vulkan
 int main() {
   using namespace NN;
-  FFN<float> ffn;
+  const std::vector<Layer<float>> layers = {{32, ACTIVATION_TYPE::NONE}, {128, ACTIVATION_TYPE::ReLU}, {64, ACTIVATION_TYPE::tanh}, {4, ACTIVATION_TYPE::sigmoid}};
+  constexpr size_t                batch  = 48;
+  FFN<float>                      ffn(layers, 64);
+
+  std::vector<float> X(batch * layers[0].size);
+  for (size_t i = 0; i < X.size(); ++i) X[i] = std::sin(0.1f * float(i));
+  const auto out = ffn.forward(X.data(), batch);
+
+  std::vector<float> h = X;
+  for (size_t l = 1; l < layers.size(); ++l) {
+    const size_t       in = layers[l - 1].size, n = layers[l].size;
+    std::vector<float> w(in * n), b(n), next(batch * n);
+    ffn.get_weights(l - 1, w.data(), b.data());
+    for (size_t r = 0; r < batch; ++r)
+      for (size_t j = 0; j < n; ++j) {
+        float z = b[j];
+        for (size_t i = 0; i < in; ++i) z += h[r * in + i] * w[i * n + j];
+        switch (layers[l].act_func_t) {
+          case ACTIVATION_TYPE::ReLU: z = ReLU(z, 1e-6f); break;
+          case ACTIVATION_TYPE::sigmoid: z = sigmoid(z); break;
+          case ACTIVATION_TYPE::tanh: z = std::tanh(z); break;
+          case ACTIVATION_TYPE::NONE: break;
+        }
+        next[r * n + j] = z;
+      }
+    h.swap(next);
+  }
+
+  float maxDiff = 0;
+  for (size_t i = 0; i < out.size(); ++i) maxDiff = std::max(maxDiff, std::abs(out[i] - h[i]));
+  for (const auto &t : ffn.timings()) std::cout << t.name << "\t" << t.ms << " ms" << std::endl;
+  std::cout << "max |device - host| = " << maxDiff << std::endl;
+  return maxDiff < 1e-4f ? 0 : 1;
 }
@@ -0,0 +1,229 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aligned.hxx>
+#include <algorithm>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Dataset untuk training FFN yang dibaca streaming dari file biner:
+ * record lebar tetap [x_0 .. x_{in-1} | y_0 .. y_{out-1}] bertipe FP, tanpa header,
+ * jadi file boleh lebih besar dari RAM. Urutan diacak dengan shuffle buffer
+ * terbatas (ambil acak dari S record, ganti dengan record berikutnya dari file),
+ * lalu dirakit jadi batch X/Y kontigu yang bisa langsung dioper ke train_batch.
+ *
+ * Satu thread producer mengisi dua slot batch bergantian (double buffer), jadi
+ * baca file dan perakitan batch berikutnya jalan bareng dengan langkah training.
+ */
+
+namespace NN {
+
+// tulis n record dari X (n × in) dan Y (n × out) row-major ke akhir file
+template <std::floating_point FP>
+void write_records(const std::string &path, const FP *X, const FP *Y, size_t n, size_t inSize, size_t outSize, bool append = false) {
+  std::ofstream ofs(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+  if (!ofs) throw std::runtime_error("write_records: can't open " + path);
+  for (size_t r = 0; r < n; ++r) {
+    ofs.write(reinterpret_cast<const char *>(X + r * inSize), sizeof(FP) * inSize);
+    ofs.write(reinterpret_cast<const char *>(Y + r * outSize), sizeof(FP) * outSize);
+  }
+  if (!ofs) throw std::runtime_error("write_records: failed writing " + path);
+}
+
+template <std::floating_point FP>
+struct Batch {
+  Linear::aligned_vector<FP> X, Y;  // size × inSize dan size × outSize
+  size_t                     size = 0;
+};
+
+template <std::floating_point FP>
+class DatasetStream {
+  const std::string path;
+  const size_t      inSize, outSize, width, batchSize, shuffleCap;
+
+  // record dibaca dari file per READ_CHUNK, cukup besar supaya syscall tidak dominan
+  static constexpr size_t READ_CHUNK = 4096;
+
+  std::ifstream              ifs;
+  std::vector<FP>            readBuf, shuffleBuf;
+  size_t                     readPos = 0, readLen = 0, shuffleLen = 0;
+  bool                       eof     = false;
+  std::mt19937_64            gen;
+  size_t                     records = 0;
+
+  /* slot[i] FULL artinya siap dipakai consumer. Batch size 0 = penanda akhir epoch,
+   * producer lanjut ke epoch berikutnya (file di-rewind) tanpa menunggu.
+   */
+  Batch<FP>               slots[2];
+  bool                    full[2] = {false, false};
+  size_t                  produceIdx = 0, consumeIdx = 0;
+  bool                    holding = false, stopping = false;
+  std::exception_ptr      error;
+  std::mutex              mtx;
+  std::condition_variable cv;
+  std::thread             producer;
+
+  // record berikutnya dari file, nullptr kalau file habis
+  const FP *read_record() {
+    if (readPos == readLen) {
+      if (eof) return nullptr;
+      ifs.read(reinterpret_cast<char *>(readBuf.data()), std::streamsize(readBuf.size() * sizeof(FP)));
+      readLen = size_t(ifs.gcount()) / sizeof(FP) / width;
+      readPos = 0;
+      if (!ifs) eof = true;
+      if (!readLen) return nullptr;
+    }
+    return readBuf.data() + width * readPos++;
+  }
+
+  void rewind() {
+    ifs.clear();
+    ifs.seekg(0);
+    readPos = readLen = 0;
+    eof               = false;
+  }
+
+  /* Ambil satu record acak dari shuffle buffer ke dst, slotnya diisi ulang dari file.
+   * Setelah file habis buffer dikuras sampai kosong. @return false kalau epoch selesai.
+   */
+  bool next_record(FP *x, FP *y) {
+    while (shuffleLen < shuffleCap) {
+      const FP *rec = read_record();
+      if (!rec) break;
+      std::copy_n(rec, width, shuffleBuf.data() + width * shuffleLen++);
+    }
+    if (!shuffleLen) return false;
+    const size_t k   = std::uniform_int_distribution<size_t>(0, shuffleLen - 1)(gen);
+    FP          *src = shuffleBuf.data() + width * k;
+    std::copy_n(src, inSize, x);
+    std::copy_n(src + inSize, outSize, y);
+    // slot yang diambil ditutup dengan record terakhir
+    std::copy_n(shuffleBuf.data() + width * --shuffleLen, width, src);
+    return true;
+  }
+
+  void fill(Batch<FP> &b) {
+    b.size = 0;
+    while (b.size < batchSize && next_record(b.X.data() + b.size * inSize, b.Y.data() + b.size * outSize)) ++b.size;
+  }
+
+  void produce() {
+    try {
+      for (;;) {
+        Batch<FP> &b = slots[produceIdx];
+        {
+          std::unique_lock lock(mtx);
+          cv.wait(lock, [&] { return stopping || !full[produceIdx]; });
+          if (stopping) return;
+        }
+        // diisi di luar lock, consumer sedang memakai slot yang lain
+        fill(b);
+        if (!b.size) rewind();
+        {
+          std::lock_guard lock(mtx);
+          full[produceIdx] = true;
+        }
+        cv.notify_all();
+        produceIdx ^= 1;
+      }
+    } catch (...) {
+      std::lock_guard lock(mtx);
+      error    = std::current_exception();
+      stopping = true;
+      cv.notify_all();
+    }
+  }
+
+ public:
+  /* @param shuffleBuffer jumlah record yang ditahan untuk diacak, 0 = urutan file.
+   * Memori yang dipakai kira-kira (shuffleBuffer + READ_CHUNK + 2 * batch) record.
+   */
+  DatasetStream(std::string path, size_t inSize, size_t outSize, size_t batch, size_t shuffleBuffer = 4096, uint64_t seed = 42)
+      : path(std::move(path)),
+        inSize(inSize),
+        outSize(outSize),
+        width(inSize + outSize),
+        batchSize(batch),
+        shuffleCap(std::max<size_t>(shuffleBuffer, 1)),
+        ifs(this->path, std::ios::binary),
+        gen(seed) {
+    if (!inSize || !outSize || !batch) throw std::invalid_argument("DatasetStream: sizes must be non-zero");
+    if (!ifs) throw std::runtime_error("DatasetStream: can't open " + this->path);
+    ifs.seekg(0, std::ios::end);
+    const auto bytes = size_t(ifs.tellg());
+    if (bytes % (width * sizeof(FP))) throw std::runtime_error("DatasetStream: file size isn't a multiple of the record size");
+    records = bytes / (width * sizeof(FP));
+    rewind();
+
+    readBuf.resize(READ_CHUNK * width);
+    shuffleBuf.resize(shuffleCap * width);
+    for (auto &s : slots) {
+      s.X.resize(batchSize * inSize);
+      s.Y.resize(batchSize * outSize);
+    }
+    producer = std::thread([this] { produce(); });
+  }
+
+  ~DatasetStream() {
+    {
+      std::lock_guard lock(mtx);
+      stopping = true;
+    }
+    cv.notify_all();
+    if (producer.joinable()) producer.join();
+  }
+
+  DatasetStream(const DatasetStream &)            = delete;
+  DatasetStream &operator=(const DatasetStream &) = delete;
+
+  size_t size() const { return records; }
+  size_t input_size() const { return inSize; }
+  size_t output_size() const { return outSize; }
+
+  /* Batch berikutnya, nullptr di akhir epoch (panggilan berikutnya mulai epoch baru).
+   * Pointer valid sampai next() dipanggil lagi, batch terakhir epoch boleh lebih kecil.
+   */
+  const Batch<FP> *next() {
+    std::unique_lock lock(mtx);
+    if (holding) {
+      full[consumeIdx] = false;
+      consumeIdx      ^= 1;
+      holding          = false;
+      cv.notify_all();
+    }
+    cv.wait(lock, [&] { return full[consumeIdx] || error; });
+    if (error) std::rethrow_exception(error);
+    holding = true;
+    return slots[consumeIdx].size ? &slots[consumeIdx] : nullptr;
+  }
+};
+
+}  // namespace NN
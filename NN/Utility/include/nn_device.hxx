@@ -0,0 +1,204 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aligned.hxx>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <dense_matrix.hxx>
+#include <gemm.hxx>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "nn_objects.hxx"
+
+/* Abstraksi backend eksekusi NN. Device memiliki memori tensornya sendiri dan
+ * mengeksekusi antrian op layer secara berurutan sambil mencatat waktu tiap op.
+ * CpuDevice di bawah adalah backend referensi tanpa ketergantungan GPU, backend
+ * lain (Vulkan, CUDA) cukup menurunkan Device dan mengimplementasikan alloc,
+ * upload, download dan run.
+ */
+
+namespace NN {
+
+// tensor 2D row-major, baris dipad ke cache line, memorinya milik device
+template <std::floating_point FP>
+struct Tensor {
+  FP    *data = nullptr;
+  size_t rows = 0, cols = 0, ld = 0;
+
+  Linear::MatrixView<FP> view() const { return Linear::MatrixView<FP>(data, rows, cols, ld, 1); }
+  std::span<FP>          row(size_t r) const { return std::span<FP>(data + r * ld, cols); }
+  // r baris pertama saja, dipakai saat batch lebih kecil dari kapasitas
+  Tensor top_rows(size_t r) const { return Tensor{data, r, cols, ld}; }
+};
+
+/* Bump allocator: satu blok rata 64 byte, alokasi cuma menggeser offset.
+ * Tidak ada free per tensor, reset() membuang semuanya sekaligus. Kapasitas
+ * tetap supaya pointer tensor yang sudah dibagikan tidak pernah pindah.
+ */
+class TensorArena {
+  Linear::aligned_vector<std::byte> block;
+  size_t                            top = 0;
+
+ public:
+  explicit TensorArena(size_t bytes = 0) : block(bytes) {}
+
+  template <std::floating_point FP>
+  Tensor<FP> alloc(size_t rows, size_t cols) {
+    const size_t ld    = Linear::pad_to_cache_line<FP>(cols);
+    const size_t bytes = Linear::pad_to_cache_line<std::byte>(rows * ld * sizeof(FP));
+    if (top + bytes > block.size())
+      throw std::runtime_error("TensorArena: out of memory, need " + std::to_string(top + bytes) + " of " + std::to_string(block.size()) + " bytes");
+    FP *p = reinterpret_cast<FP *>(block.data() + top);
+    std::memset(p, 0, bytes);
+    top += bytes;
+    return Tensor<FP>{p, rows, cols, ld};
+  }
+
+  // semua tensor yang pernah dialokasikan jadi tidak valid
+  void reset() { top = 0; }
+  // ganti kapasitas, hanya boleh saat arena kosong
+  void reserve(size_t bytes) {
+    if (top) throw std::logic_error("TensorArena: reserve on a non-empty arena");
+    block.resize(bytes);
+  }
+
+  size_t used() const { return top; }
+  size_t capacity() const { return block.size(); }
+
+  // byte yang dipakai alloc<FP>(rows, cols), untuk menghitung kapasitas di depan
+  template <std::floating_point FP>
+  static constexpr size_t bytes_for(size_t rows, size_t cols) {
+    return Linear::pad_to_cache_line<std::byte>(rows * Linear::pad_to_cache_line<FP>(cols) * sizeof(FP));
+  }
+};
+
+enum OP_TYPE { OP_DENSE, OP_ACTIVATION };
+
+/* OP_DENSE      : out = act(in · w + b), w in × out, b 1 × out
+ * OP_ACTIVATION : out = act(out), in/w/b tidak dipakai
+ */
+template <std::floating_point FP>
+struct LayerOp {
+  OP_TYPE         type = OP_DENSE;
+  std::string     name;
+  Tensor<FP>      in, out, w, b;
+  ACTIVATION_TYPE act = ACTIVATION_TYPE::NONE;
+};
+
+struct OpTiming {
+  std::string name;
+  double      ms;
+};
+
+template <std::floating_point FP>
+class Device {
+ protected:
+  std::vector<LayerOp<FP>> queue;
+  std::vector<OpTiming>    lastTimings;
+
+ public:
+  virtual ~Device() = default;
+
+  virtual const char *name() const = 0;
+  virtual Tensor<FP>  alloc(size_t rows, size_t cols) = 0;
+  // host → device dan sebaliknya, src/dst host row-major rapat (rows × cols)
+  virtual void        upload(const Tensor<FP> &dst, const FP *src) = 0;
+  virtual void        download(const Tensor<FP> &src, FP *dst) = 0;
+  // eksekusi semua op di antrian berurutan, waktu tiap op bisa dibaca lewat timings()
+  virtual void        run() = 0;
+
+  void enqueue(LayerOp<FP> op) { queue.push_back(std::move(op)); }
+  void clear_queue() { queue.clear(); }
+
+  const std::vector<LayerOp<FP>> &ops() const { return queue; }
+  const std::vector<OpTiming>    &timings() const { return lastTimings; }
+};
+
+/* Backend CPU: tensor di TensorArena, dense lewat gemm lalu epilogue bias +
+ * aktivasi per baris. Paralelnya lewat tim OpenMP (gemm dan loop baris), thread
+ * pool-nya dipakai ulang runtime antar op jadi tidak ada thread baru per langkah.
+ */
+template <std::floating_point FP>
+class CpuDevice final : public Device<FP> {
+  TensorArena arena_;
+  FP          epsilon = FP(1e-6);
+  bool        precise = false;
+
+  // epilogue baru diparalelkan kalau elemennya cukup banyak
+  static constexpr size_t PARALLEL_MIN = 1 << 14;
+
+  void dense(const LayerOp<FP> &op) {
+    if (op.in.cols != op.w.rows || op.w.cols != op.out.cols || op.in.rows != op.out.rows || op.b.cols != op.out.cols)
+      throw std::invalid_argument("CpuDevice: dense shape mismatch in op " + op.name);
+    Linear::gemm<FP>(1, op.in.view(), op.w.view(), 0, op.out.view());
+    const FP    *b = op.b.data;
+    const size_t n = op.out.cols;
+#pragma omp parallel for schedule(static) if (op.out.rows * n >= PARALLEL_MIN)
+    for (size_t r = 0; r < op.out.rows; ++r) {
+      FP *y = op.out.row(r).data();
+#pragma omp simd
+      for (size_t i = 0; i < n; ++i) y[i] += b[i];
+      apply_activation(op.out.row(r), op.act, epsilon, precise);
+    }
+  }
+
+  void activation(const LayerOp<FP> &op) {
+#pragma omp parallel for schedule(static) if (op.out.rows * op.out.cols >= PARALLEL_MIN)
+    for (size_t r = 0; r < op.out.rows; ++r) apply_activation(op.out.row(r), op.act, epsilon, precise);
+  }
+
+ public:
+  explicit CpuDevice(size_t arenaBytes) : arena_(arenaBytes) {}
+
+  const char *name() const override { return "CPU"; }
+  Tensor<FP>  alloc(size_t rows, size_t cols) override { return arena_.alloc<FP>(rows, cols); }
+
+  void upload(const Tensor<FP> &dst, const FP *src) override {
+    for (size_t r = 0; r < dst.rows; ++r) std::memcpy(dst.row(r).data(), src + r * dst.cols, sizeof(FP) * dst.cols);
+  }
+  void download(const Tensor<FP> &src, FP *dst) override {
+    for (size_t r = 0; r < src.rows; ++r) std::memcpy(dst + r * src.cols, src.row(r).data(), sizeof(FP) * src.cols);
+  }
+
+  void run() override {
+    using clock = std::chrono::steady_clock;
+    this->lastTimings.clear();
+    for (const auto &op : this->queue) {
+      const auto start = clock::now();
+      switch (op.type) {
+        case OP_DENSE: dense(op); break;
+        case OP_ACTIVATION: activation(op); break;
+      }
+      this->lastTimings.push_back({op.name, std::chrono::duration<double, std::milli>(clock::now() - start).count()});
+    }
+  }
+
+  TensorArena &arena() { return arena_; }
+  void         set_epsilon(FP eps) { epsilon = eps; }
+  void         set_precise_activation(bool p) { precise = p; }
+};
+
+}  // namespace NN
@@ -19,74 +19,56 @@
 
 #pragma once
 
-#include <algorithm>
-#include <cassert>
 #include <concepts>
-#include <optional>
-#include <sstream>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
+
+#if __has_include(<vulkan/vulkan_raii.hpp>)
 #include <vulkan/vulkan_raii.hpp>
+#define NN_HAS_VULKAN 1
+#endif
 
+#include "nn_device.hxx"
 #include "nn_objects.hxx"
 
-// currently just a placeholder
+/* NNHandler memilih backend sesuai COMPUTE_MODE dan meneruskan eksekusi ke Device.
+ * Saat ini yang ada baru CpuDevice, mode GPU cuma mendeteksi driver; backend GPU
+ * nanti tinggal menurunkan Device<FP> dan dibuat di make_device().
+ */
 namespace NN {
 enum GPU_MODE { cuda = 1, vulkan = 2, opencl = 4, metal = 8, NONE = 0 };
 template <std::floating_point FP>
 class NNHandler {
-  const std::string engineName = "NO ENGINE", appName = "Neural Network Compute Layer";
-  Layer<FP>         layer;
-  std::string       compute_shader;
-  uint32_t         *vulkan_spir_v;
-  COMPUTE_MODE      mode;
-  int               gpu_mode;
-
-  // vulkan section
-  vk::raii::Context                               context;
-  std::optional<vk::raii::Instance>               instance;
-  std::optional<vk::raii::DebugUtilsMessengerEXT> debugMessenger;
-
-  vk::PhysicalDevice              physicalDevice{nullptr};
-  std::optional<vk::raii::Device> device;
-  vk::Queue                       computeQueue{nullptr};
-  uint32_t                        computeQueueFamilyIndex = 0;
-
-  std::optional<vk::raii::CommandPool> commandPool;
-  std::vector<vk::CommandBuffer>       commandBuffers;
-
-  std::optional<vk::raii::PipelineLayout> pipelineLayout;
-  std::optional<vk::raii::Pipeline>       computePipeline;
-
-  std::optional<vk::raii::DescriptorSetLayout> descriptorSetLayout;
-  std::optional<vk::raii::DescriptorPool>      descriptorPool;
-  std::vector<vk::DescriptorSet>               descriptorSets;
-
-  std::optional<vk::raii::Buffer>       inputBuffer;
-  std::optional<vk::raii::DeviceMemory> inputBufferMemory;
-
-  std::optional<vk::raii::Buffer>       outputBuffer;
-  std::optional<vk::raii::DeviceMemory> outputBufferMemory;
-
-  std::optional<vk::raii::Fence> computeFence;
+  COMPUTE_MODE                mode;
+  int                         gpu_mode = GPU_MODE::NONE;
+  size_t                      arenaBytes;
+  std::unique_ptr<Device<FP>> device;
 
   // check availabily driver for the api, unimplemented yet other than vulkan
-  int validate_gpu_mode() const {
+  static int validate_gpu_mode() {
     int res = 0;
-
+#ifdef NN_HAS_VULKAN
     // check if vulkan is available
     if (vk::raii::Context::getGlobalContext().isVulkanAvailable()) res |= GPU_MODE::vulkan;
-
+#endif
     return res;
   }
 
-  void create_vulkan_shader() {}
+  std::unique_ptr<Device<FP>> make_device() const {
+    if (mode == COMPUTE_MODE::CPU) return std::make_unique<CpuDevice<FP>>(arenaBytes);
+    throw std::runtime_error("NNHandler: no GPU backend implemented yet, use COMPUTE_MODE::CPU");
+  }
 
  public:
-  explicit NNHandler(COMPUTE_MODE mode) : mode(mode) {
-    if (mode == COMPUTE_MODE::COMPUTE_CPU) return;
-    gpu_mode = validate_gpu_mode();
-    assert(gpu_mode != GPU_MODE::NONE && "No GPU mode available, please check your drivers or use CPU mode.");
+  // arenaBytes = kapasitas memori tensor device (bobot + aktivasi)
+  explicit NNHandler(COMPUTE_MODE mode, size_t arenaBytes) : mode(mode), arenaBytes(arenaBytes) {
+    if (mode == COMPUTE_MODE::GPU) {
+      gpu_mode = validate_gpu_mode();
+      if (gpu_mode == GPU_MODE::NONE) throw std::runtime_error("NNHandler: no GPU mode available, please check your drivers or use CPU mode");
+    }
+    device = make_device();
   }
   NNHandler() = delete;
 
@@ -95,79 +77,19 @@ class NNHandler {
     return static_cast<GPU_MODE>(gpu_mode);
   }
 
-  void set_layer(const Layer<FP> &layer) { this->layer = layer; }
-  bool set_mode(COMPUTE_MODE m) {}
-
   /* this method is used to set the GPU mode
   if compute mode is CPU, this method is useless
   */
-  void set_gpu_mode(GPU_MODE mode) {
-    if (mode == COMPUTE_MODE::CPU || !(get_gpu_mode() & mode)) return;
-    gpu_mode = mode;
+  void set_gpu_mode(GPU_MODE m) {
+    if (mode == COMPUTE_MODE::CPU || !(validate_gpu_mode() & m)) return;
+    gpu_mode = m;
   }
 
-  // run compute for each layer, unimplemented yet
-  void run() {
-    // if on the cpu mode, just return outputs = w.x + b overloaded by class matrix and custom overload vector
-    if (mode == COMPUTE_MODE::CPU) {
-      layer.outputs = layer.w * layer.inputs + layer.b;
-      return;
-    }
-
-    // cuda priority is 1
-    if (gpu_mode & GPU_MODE::cuda) {
-      // CUDA mode, implement cuda kernel here
-      // This is just a placeholder, you need to implement the actual cuda kernel
-      // and launch it with the inputs and outputs
-      return;
-    }
+  COMPUTE_MODE get_mode() const { return mode; }
+  Device<FP>  &get_device() { return *device; }
 
-    // vulkan priority is 2 since cuda more powerfull
-    if (gpu_mode & GPU_MODE::vulkan) {
-      if (!instance.has_value()) {
-        // for safety using default available api version
-        const uint32_t      apiVers = enumerateInstanceVersion();
-        vk::ApplicationInfo appInfo{engineName, 1, appName, apiVers};
-        instance.emplace(vk::createInstance(context, appInfo));
-      }
-
-      if (!physicalDevice) {
-        vector<physicalDevice> physicalDevices = instance->enumeratePhysicalDevices();
-        assert(!physicalDevices.empty());
-        physicalDevice = physicalDevices[0];
-      }
-
-      // create device
-      if (!device.has_value()) {
-        vector<::QueueFamilyProperties> queueFamProps = physDev.getQueueFamilyProperties();
-        auto                            queueFamProp =
-            find_if(queueFamProps.begin(), queueFamProps.end(), [](QueueFamilyProperties &qFProp) { return qFProp.queueFlags & ::QueueFlagBits::eCompute; });
-        computeQueueFamilyIndex          = std::distance(queueFamProps.begin(), queueFamProp);
-        const float           priorities = 1.0;
-        DeviceQueueCreateInfo devQueueInfo(DeviceQueueCreateFlags(), computeQueueFamilyIndex, 1, &priorities);
-        DeviceCreateInfo      devInfo(DeviceCreateFlags(), devQueueInfo);
-        Device                dev = physDev.createDevice(devInfo);
-      }
-
-      // create buffer and fill
-      if (!inputBuffer.has_value()) {}
-      if (!inputBufferMemory.has_value()) {}
-      if (!outputBuffer.has_value()) {}
-      if (!outputBufferMemory.has_value()) {}
-
-      std::stringstream shaderstream;
-
-      // unimplemented yet
-      shaderstream << "" << std::endl;
-
-      compute_shader = shaderstream.str();
-      // call create vulkan shader method
-      create_vulkan_shader();
-
-      return;
-    }
-
-    // the last doesnt need if for checking
-  }
+  // eksekusi antrian op di device, waktu tiap op ada di timings()
+  void                        run() { device->run(); }
+  const std::vector<OpTiming> &timings() const { return device->timings(); }
 };
-}  // namespace NN
\ No newline at end of file
+}  // namespace NN
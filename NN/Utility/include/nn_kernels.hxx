@@ -0,0 +1,112 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+/* Kernel vektor kecil yang dipakai bareng oleh FFN.
+ * Semua loop unit stride dan ditandai omp simd, jadi dengan -O3 -march=native
+ * (plus -fopenmp atau -fopenmp-simd) compiler mengeluarkan instruksi vektor
+ * AVX2/AVX-512/NEON sendiri, reduksi float juga boleh diurutkan ulang.
+ */
+
+namespace NN::kernel {
+
+// Σ a[i] * b[i]
+template <std::floating_point FP>
+inline FP dot(const FP *__restrict a, const FP *__restrict b, size_t n) {
+  FP sum = 0;
+#pragma omp simd reduction(+ : sum)
+  for (size_t i = 0; i < n; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+// y += alpha * x
+template <std::floating_point FP>
+inline void axpy(FP alpha, const FP *__restrict x, FP *__restrict y, size_t n) {
+#pragma omp simd
+  for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+/* exp cepat tanpa cabang supaya bisa divektorkan di dalam loop omp simd:
+ * x = n·ln2 + r dengan |r| <= ln2/2, e^r lewat polinomial Taylor (Horner),
+ * 2^n dirakit langsung di bit eksponen: n + 1.5·2^52 menaruh n di bit mantisa
+ * bawah, jadi cukup operasi integer 64 bit yang ada di AVX2. Pembulatan n lewat
+ * nearbyint, bukan (x + shifter) - shifter yang dilipat habis oleh -ffast-math.
+ * Error relatif <= ~1e-14 (double, derajat 11) / ~2e-7 (float, derajat 6),
+ * input dijepit ke rentang yang tidak overflow/denormal.
+ */
+template <std::floating_point FP>
+inline FP fast_exp(FP x) {
+  if constexpr (sizeof(FP) == 8) {
+    constexpr double shifter = 0x1.8p52, log2e = 1.4426950408889634, ln2Hi = 0x1.62e42fefa3800p-1, ln2Lo = 0x1.ef35793c76730p-45;
+    const double     xc = std::clamp(double(x), -708.0, 709.0);
+    const double     n  = std::nearbyint(xc * log2e);
+    const double     kd = n + shifter;
+    const double     r  = xc - n * ln2Hi - n * ln2Lo;
+    double           p  = 1.0 / 39916800;
+    p                   = p * r + 1.0 / 3628800;
+    p                   = p * r + 1.0 / 362880;
+    p                   = p * r + 1.0 / 40320;
+    p                   = p * r + 1.0 / 5040;
+    p                   = p * r + 1.0 / 720;
+    p                   = p * r + 1.0 / 120;
+    p                   = p * r + 1.0 / 24;
+    p                   = p * r + 1.0 / 6;
+    p                   = p * r + 0.5;
+    p                   = p * r + 1;
+    p                   = p * r + 1;
+    const uint64_t scale = (std::bit_cast<uint64_t>(kd) + 1023) << 52;
+    return FP(p * std::bit_cast<double>(scale));
+  } else {
+    constexpr float shifter = 0x1.8p23f, log2e = 1.44269504f, ln2Hi = 0x1.62e4p-1f, ln2Lo = 0x1.7f7d1cp-20f;
+    const float     xc = std::clamp(float(x), -87.0f, 88.0f);
+    const float     n  = std::nearbyint(xc * log2e);
+    const float     kd = n + shifter;
+    const float     r  = xc - n * ln2Hi - n * ln2Lo;
+    float           p  = 1.0f / 720;
+    p                  = p * r + 1.0f / 120;
+    p                  = p * r + 1.0f / 24;
+    p                  = p * r + 1.0f / 6;
+    p                  = p * r + 0.5f;
+    p                  = p * r + 1;
+    p                  = p * r + 1;
+    const uint32_t scale = (std::bit_cast<uint32_t>(kd) + 127) << 23;
+    return FP(p * std::bit_cast<float>(scale));
+  }
+}
+
+template <std::floating_point FP>
+inline FP fast_sigmoid(FP x) {
+  return 1 / (1 + fast_exp(-x));
+}
+
+// tanh(x) = 1 - 2 / (e^2x + 1), stabil untuk |x| besar, error absolut setara fast_exp
+template <std::floating_point FP>
+inline FP fast_tanh(FP x) {
+  return 1 - 2 / (fast_exp(2 * x) + 1);
+}
+
+}  // namespace NN::kernel
@@ -0,0 +1,287 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aligned.hxx>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <dense_matrix.hxx>
+#include <fstream>
+#include <nn_kernels.hxx>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Format file model bersama untuk FFN (ekstensi .nnm), little-endian:
+ *
+ *   [FileHeader 64 B][LayerRecord 32 B × nLayers][padding][payload]
+ *
+ * Payload mulai di offset kelipatan 64, tiap tensor juga rata 64 byte. Bobot layer
+ * disimpan out × in row-major (baris = neuron output) dengan leading dimension ld
+ * yang dipad ke cache line, sama dengan layout BasicFFN::Layer, lalu bias panjang out.
+ * Checksum FNV-1a per word 64 bit atas seluruh payload.
+ *
+ * Karena semua offset rata, file bisa di-mmap read-only dan bobotnya dipakai langsung
+ * sebagai MatrixView tanpa copy: banyak proses berbagi satu salinan di page cache.
+ */
+
+namespace NN::model {
+
+inline constexpr char     MAGIC[8] = {'N', 'N', 'M', 'O', 'D', 'E', 'L', '\0'};
+inline constexpr uint32_t VERSION  = 1;
+
+// kode aktivasi di file, sengaja terpisah dari enum aktivasi tiap model
+enum MODEL_ACTIVATION : uint32_t { ACT_NONE, ACT_RELU, ACT_SIGMOID, ACT_TANH };
+enum MODEL_DTYPE : uint32_t { DTYPE_F32 = 1, DTYPE_F64 = 2 };
+
+struct FileHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t dtype;
+  uint32_t alignment;
+  uint32_t nLayers;
+  uint64_t payloadOffset;
+  uint64_t payloadSize;
+  uint64_t checksum;
+  double   reluEpsilon;  // ReLU di repo ini mengembalikan epsilon untuk x <= 0
+  uint8_t  reserved[8];
+};
+static_assert(sizeof(FileHeader) == 64);
+
+struct LayerRecord {
+  uint32_t in, out, ld, activation;
+  uint64_t weightOffset, biasOffset;  // relatif ke awal payload, dalam byte
+};
+static_assert(sizeof(LayerRecord) == 32);
+
+template <std::floating_point FP>
+constexpr MODEL_DTYPE dtype_of() {
+  return sizeof(FP) == 4 ? DTYPE_F32 : DTYPE_F64;
+}
+
+// FNV-1a per word 64 bit, bytes harus kelipatan 8 (payload selalu kelipatan 64)
+inline uint64_t checksum(const void *data, size_t bytes) {
+  uint64_t       h = 0xcbf29ce484222325ull;
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < bytes; i += 8) {
+    uint64_t w;
+    std::memcpy(&w, p + i, 8);
+    h = (h ^ w) * 0x100000001b3ull;
+  }
+  return h;
+}
+
+template <std::floating_point FP>
+inline FP apply_activation(uint32_t act, FP x, FP reluEpsilon) {
+  switch (act) {
+    case ACT_RELU: return x > 0 ? x : reluEpsilon;
+    case ACT_SIGMOID: return 1 / (1 + std::exp(-x));
+    case ACT_TANH: return std::tanh(x);
+    default: return x;
+  }
+}
+
+/* Kumpulkan layer lalu tulis sekali. Bobot langsung disalin ke payload saat
+ * add_layer, jadi sumbernya boleh view transpose atau buffer sementara.
+ */
+template <std::floating_point FP>
+class ModelWriter {
+  std::vector<LayerRecord>   records;
+  Linear::aligned_vector<FP> payload;
+  FP                         reluEpsilon = 0;
+
+ public:
+  explicit ModelWriter(FP reluEpsilon = 0) : reluEpsilon(reluEpsilon) {}
+
+  // W berukuran out × in (baris = neuron output), b panjang out
+  void add_layer(Linear::MatrixView<const FP> W, const FP *b, MODEL_ACTIVATION act) {
+    const size_t in = W.cols(), out = W.rows(), ld = Linear::pad_to_cache_line<FP>(in);
+    const size_t wOff = payload.size(), bOff = wOff + out * ld;
+    payload.resize(bOff + Linear::pad_to_cache_line<FP>(out), 0);
+    for (size_t o = 0; o < out; ++o)
+      for (size_t i = 0; i < in; ++i) payload[wOff + o * ld + i] = W(o, i);
+    std::copy(b, b + out, payload.begin() + bOff);
+    records.push_back({uint32_t(in), uint32_t(out), uint32_t(ld), act, wOff * sizeof(FP), bOff * sizeof(FP)});
+  }
+
+  void save(const std::string &path) const {
+    static_assert(std::endian::native == std::endian::little, "model file is little-endian");
+    FileHeader hdr{};
+    std::memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+    hdr.version       = VERSION;
+    hdr.dtype         = dtype_of<FP>();
+    hdr.alignment     = Linear::CACHE_LINE;
+    hdr.nLayers       = uint32_t(records.size());
+    hdr.payloadOffset = (sizeof(FileHeader) + records.size() * sizeof(LayerRecord) + Linear::CACHE_LINE - 1) / Linear::CACHE_LINE * Linear::CACHE_LINE;
+    hdr.payloadSize   = payload.size() * sizeof(FP);
+    hdr.checksum      = checksum(payload.data(), hdr.payloadSize);
+    hdr.reluEpsilon   = double(reluEpsilon);
+
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    if (!ofs) throw std::runtime_error("ModelWriter: can't open " + path);
+    ofs.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    ofs.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(LayerRecord));
+    const std::vector<char> pad(hdr.payloadOffset - sizeof(hdr) - records.size() * sizeof(LayerRecord), 0);
+    ofs.write(pad.data(), pad.size());
+    ofs.write(reinterpret_cast<const char *>(payload.data()), hdr.payloadSize);
+    if (!ofs) throw std::runtime_error("ModelWriter: failed writing " + path);
+  }
+};
+
+/* File read-only yang di-mmap utuh (fallback: dibaca ke buffer rata 64 byte).
+ * Halaman baru dimuat kernel saat disentuh, jadi membuka model besar hampir instan.
+ */
+class MappedFile {
+  const std::byte *ptr = nullptr;
+  size_t           len = 0;
+#ifdef _WIN32
+  Linear::aligned_vector<std::byte> buf;
+#endif
+
+ public:
+  explicit MappedFile(const std::string &path) {
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("MappedFile: can't open " + path);
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      throw std::runtime_error("MappedFile: can't stat " + path);
+    }
+    len       = size_t(st.st_size);
+    void *map = ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // mapping tetap hidup setelah fd ditutup
+    if (map == MAP_FAILED) throw std::runtime_error("MappedFile: mmap failed for " + path);
+    ptr = static_cast<const std::byte *>(map);
+#else
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs) throw std::runtime_error("MappedFile: can't open " + path);
+    len = size_t(ifs.tellg());
+    buf.resize(len);
+    ifs.seekg(0);
+    ifs.read(reinterpret_cast<char *>(buf.data()), len);
+    ptr = buf.data();
+#endif
+  }
+  ~MappedFile() {
+#ifndef _WIN32
+    if (ptr) ::munmap(const_cast<std::byte *>(ptr), len);
+#endif
+  }
+  MappedFile(const MappedFile &)            = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const std::byte *data() const { return ptr; }
+  size_t           size() const { return len; }
+};
+
+/* Model yang dibuka dari file, bobot dipakai langsung dari mapping.
+ * verify = false melewati checksum (yang harus menyentuh semua halaman) kalau
+ * file sudah dipercaya dan start secepat mungkin lebih penting.
+ */
+template <std::floating_point FP>
+class MappedModel {
+  MappedFile         file;
+  const FileHeader  *hdr  = nullptr;
+  const LayerRecord *recs = nullptr;
+  size_t             maxWidth = 0;
+
+  const std::byte *payload() const { return file.data() + hdr->payloadOffset; }
+
+ public:
+  explicit MappedModel(const std::string &path, bool verify = true) : file(path) {
+    if (file.size() < sizeof(FileHeader)) throw std::runtime_error("MappedModel: file too small");
+    hdr = reinterpret_cast<const FileHeader *>(file.data());
+    if (std::memcmp(hdr->magic, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error("MappedModel: bad magic");
+    if (hdr->version != VERSION) throw std::runtime_error("MappedModel: unsupported version " + std::to_string(hdr->version));
+    if (hdr->dtype != dtype_of<FP>()) throw std::runtime_error("MappedModel: dtype doesn't match FP");
+    if (hdr->alignment != Linear::CACHE_LINE || hdr->payloadOffset % Linear::CACHE_LINE) throw std::runtime_error("MappedModel: bad alignment");
+    /* Semua batas dicek dalam bentuk pengurangan supaya header korup tidak bisa
+     * membuat penjumlahan offset + size wrap lalu lolos dan membaca di luar mapping. */
+    if (hdr->payloadOffset < sizeof(FileHeader) || uint64_t(hdr->nLayers) * sizeof(LayerRecord) > hdr->payloadOffset - sizeof(FileHeader) ||
+        hdr->payloadOffset > file.size() || hdr->payloadSize > file.size() - hdr->payloadOffset)
+      throw std::runtime_error("MappedModel: truncated file");
+    // checksum() membaca word 8 byte utuh, payload yang ditulis selalu kelipatan cache line
+    if (hdr->payloadSize % Linear::CACHE_LINE) throw std::runtime_error("MappedModel: bad payload size");
+    recs = reinterpret_cast<const LayerRecord *>(file.data() + sizeof(FileHeader));
+
+    for (size_t l = 0; l < hdr->nLayers; ++l) {
+      const LayerRecord &r = recs[l];
+      // out·ld < 2^64 karena keduanya 32 bit, pembanding dibagi sizeof(FP) supaya tidak wrap
+      if (r.ld < r.in || r.weightOffset % Linear::CACHE_LINE || r.biasOffset % Linear::CACHE_LINE || r.weightOffset > hdr->payloadSize ||
+          r.biasOffset > hdr->payloadSize || uint64_t(r.out) * r.ld > (hdr->payloadSize - r.weightOffset) / sizeof(FP) ||
+          uint64_t(r.out) > (hdr->payloadSize - r.biasOffset) / sizeof(FP))
+        throw std::runtime_error("MappedModel: bad layer record " + std::to_string(l));
+      if (l && r.in != recs[l - 1].out) throw std::runtime_error("MappedModel: layer " + std::to_string(l) + " shape doesn't chain");
+      maxWidth = std::max({maxWidth, size_t(r.in), size_t(r.out)});
+    }
+    if (verify && checksum(payload(), hdr->payloadSize) != hdr->checksum) throw std::runtime_error("MappedModel: checksum mismatch");
+  }
+
+  size_t             layers() const { return hdr->nLayers; }
+  const LayerRecord &layer(size_t l) const { return recs[l]; }
+  FP                 relu_epsilon() const { return FP(hdr->reluEpsilon); }
+  size_t             input_size() const { return layers() ? recs[0].in : 0; }
+  size_t             output_size() const { return layers() ? recs[layers() - 1].out : 0; }
+
+  // out × in, langsung menunjuk ke mapping
+  Linear::MatrixView<const FP> weights(size_t l) const {
+    const LayerRecord &r = recs[l];
+    return Linear::MatrixView<const FP>(reinterpret_cast<const FP *>(payload() + r.weightOffset), r.out, r.in, r.ld, 1);
+  }
+  const FP *bias(size_t l) const { return reinterpret_cast<const FP *>(payload() + recs[l].biasOffset); }
+
+  // satu sampel, out minimal output_size() elemen, bobot dibaca dari mapping
+  void forward(const FP *in, FP *out) const {
+    thread_local std::vector<FP> bufs[2];
+    for (auto &b : bufs)
+      if (b.size() < maxWidth) b.resize(maxWidth);
+    const FP *x   = in;
+    const FP  eps = relu_epsilon();
+    for (size_t l = 0; l < layers(); ++l) {
+      const auto r = recs[l];
+      const auto W = weights(l);
+      const FP  *b = bias(l);
+      FP        *y = l + 1 == layers() ? out : bufs[l & 1].data();
+      for (size_t o = 0; o < r.out; ++o) y[o] = apply_activation(r.activation, kernel::dot(W.row(o).data(), x, r.in) + b[o], eps);
+      x = y;
+    }
+  }
+
+  // X batch × input_size(), Y batch × output_size(), row-major, sampel dibagi ke thread
+  void forward_batch(const FP *X, FP *Y, size_t batch) const {
+#pragma omp parallel for schedule(static) if (batch > 1)
+    for (size_t r = 0; r < batch; ++r) forward(X + r * input_size(), Y + r * output_size());
+  }
+};
+
+}  // namespace NN::model
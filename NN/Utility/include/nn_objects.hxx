@@ -21,6 +21,8 @@
 
 #include <cmath>
 #include <concepts>
+#include <nn_kernels.hxx>
+#include <span>
 #include <vector>
 
 namespace NN {
@@ -64,13 +66,69 @@ inline FP Sigmoid_deriv(FP y) {
 // Tanh activation function
 template <std::floating_point FP>
 inline FP tanh(FP x) {
-  return (std::exp(x) - std::exp(-x)) / (std::exp(x) + std::exp(-x));
+  return std::tanh(x);
 }
 // Tanh derivative function
 template <std::floating_point FP>
 inline FP tanh_deriv(FP y) {
   return 1 - y * y;
 }
+/* Aktivasi satu array sekaligus, switch cuma sekali di luar loop.
+ * precise = false memakai exp/sigmoid/tanh cepat dari nn_kernels.hxx (error
+ * ~1e-14 double / ~2e-7 float), precise = true memakai std::exp/std::tanh.
+ */
+template <std::floating_point FP>
+inline void apply_activation(std::span<FP> x, ACTIVATION_TYPE t, FP epsilon = 0, bool precise = false) {
+  FP          *p = x.data();
+  const size_t n = x.size();
+  switch (t) {
+    case ACTIVATION_TYPE::ReLU:
+#pragma omp simd
+      for (size_t i = 0; i < n; ++i) p[i] = p[i] > 0 ? p[i] : epsilon;
+      break;
+    case ACTIVATION_TYPE::sigmoid:
+      if (precise)
+        for (size_t i = 0; i < n; ++i) p[i] = sigmoid(p[i]);
+      else {
+#pragma omp simd
+        for (size_t i = 0; i < n; ++i) p[i] = kernel::fast_sigmoid(p[i]);
+      }
+      break;
+    case ACTIVATION_TYPE::tanh:
+      if (precise)
+        for (size_t i = 0; i < n; ++i) p[i] = std::tanh(p[i]);
+      else {
+#pragma omp simd
+        for (size_t i = 0; i < n; ++i) p[i] = kernel::fast_tanh(p[i]);
+      }
+      break;
+    case ACTIVATION_TYPE::NONE: break;
+  }
+}
+
+// d ⊙= f'(y), y = output aktivasi (turunan semua aktivasi di sini cukup dari y)
+template <std::floating_point FP>
+inline void apply_activation_deriv(std::span<FP> d, std::span<const FP> y, ACTIVATION_TYPE t, FP epsilon = 0) {
+  FP          *pd = d.data();
+  const FP    *py = y.data();
+  const size_t n  = d.size();
+  switch (t) {
+    case ACTIVATION_TYPE::ReLU:
+#pragma omp simd
+      for (size_t i = 0; i < n; ++i) pd[i] *= py[i] > 0 ? FP(1) : epsilon;
+      break;
+    case ACTIVATION_TYPE::sigmoid:
+#pragma omp simd
+      for (size_t i = 0; i < n; ++i) pd[i] *= py[i] * (1 - py[i]);
+      break;
+    case ACTIVATION_TYPE::tanh:
+#pragma omp simd
+      for (size_t i = 0; i < n; ++i) pd[i] *= 1 - py[i] * py[i];
+      break;
+    case ACTIVATION_TYPE::NONE: break;
+  }
+}
+
 // Mean Absolute Error Loss Function
 template <std::floating_point FP>
 inline FP MAE(FP ypred, FP y) {
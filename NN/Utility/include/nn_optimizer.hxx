@@ -0,0 +1,161 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aligned.hxx>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/* Optimizer untuk FFN. State (momentum, m, v) disimpan di array flat rata cache
+ * line, satu slot per tensor parameter dengan panjang yang sama. Update satu tensor
+ * adalah satu pass: baca w, g, state lalu tulis w dan state, dibagi per chunk ke
+ * thread dan divektorkan di dalam chunk, jadi cuma dibatasi bandwidth memori.
+ *
+ *   SGD      : w -= lr · g
+ *   MOMENTUM : u = μu + g,  w -= lr · u
+ *   ADAM     : g += λw,  m = β1m + (1-β1)g,  v = β2v + (1-β2)g²,  w -= lr · m̂ / (√v̂ + ε)
+ *   ADAMW    : seperti ADAM tapi weight decay dipisah: w -= lr · (m̂ / (√v̂ + ε) + λw)
+ *
+ * λ hanya dipakai untuk tensor yang didaftarkan dengan decay = true. Bias biasanya
+ * didaftarkan tanpa decay: menarik bias ke nol tidak mengurangi kompleksitas model,
+ * cuma menggeser output.
+ */
+
+namespace NN {
+
+enum OPTIMIZER_TYPE { OPT_SGD, OPT_MOMENTUM, OPT_ADAM, OPT_ADAMW };
+
+template <std::floating_point FP>
+struct OptimizerConfig {
+  OPTIMIZER_TYPE type        = OPT_SGD;
+  FP             lr          = FP(1e-2);
+  FP             momentum    = FP(0.9);
+  FP             beta1       = FP(0.9);
+  FP             beta2       = FP(0.999);
+  FP             eps         = FP(1e-8);
+  FP             weightDecay = FP(0);
+};
+
+template <std::floating_point FP>
+class Optimizer {
+  struct Slot {
+    size_t                     n     = 0;
+    bool                       decay = true;  // false → λ diabaikan untuk tensor ini
+    Linear::aligned_vector<FP> m, v;          // MOMENTUM cuma pakai m
+  };
+
+  OptimizerConfig<FP> cfg;
+  std::vector<Slot>   slots;
+  size_t              t  = 0;
+  FP                  c1 = 1, c2 = 1;  // koreksi bias Adam 1 / (1 - β^t)
+
+  // elemen per chunk thread, 4096 FP × 4 array masih muat di L2
+  static constexpr size_t CHUNK = 4096;
+
+  template <typename F>
+  static void for_chunks(size_t n, F &&f) {
+    const size_t chunks = (n + CHUNK - 1) / CHUNK;
+#pragma omp parallel for schedule(static) if (chunks > 1)
+    for (size_t c = 0; c < chunks; ++c) f(c * CHUNK, std::min(n, (c + 1) * CHUNK));
+  }
+
+ public:
+  explicit Optimizer(OptimizerConfig<FP> cfg = {}) : cfg(cfg) {}
+
+  // daftarkan tensor parameter n elemen, decay = false untuk bias, @return id untuk update()
+  size_t add_tensor(size_t n, bool decay = true) {
+    Slot s;
+    s.n     = n;
+    s.decay = decay;
+    if (cfg.type != OPT_SGD) s.m.assign(n, 0);
+    if (cfg.type == OPT_ADAM || cfg.type == OPT_ADAMW) s.v.assign(n, 0);
+    slots.push_back(std::move(s));
+    return slots.size() - 1;
+  }
+
+  // panggil sekali per langkah training sebelum update() tiap tensor
+  void begin_step() {
+    ++t;
+    c1 = 1 / (1 - std::pow(cfg.beta1, FP(t)));
+    c2 = 1 / (1 - std::pow(cfg.beta2, FP(t)));
+  }
+
+  /* w -= langkah optimizer dengan gradien gScale · g, n harus sama dengan yang
+   * didaftarkan. gScale biasanya 1 / batch supaya gradien batch tidak perlu diskala dulu.
+   */
+  void update(size_t id, FP *w, const FP *g, FP gScale = 1) {
+    if (id >= slots.size()) throw std::out_of_range("Optimizer: unknown tensor id");
+    Slot    &s  = slots[id];
+    const FP lr = cfg.lr, wd = s.decay ? cfg.weightDecay : FP(0), mu = cfg.momentum, b1 = cfg.beta1, b2 = cfg.beta2, eps = cfg.eps;
+    const FP c1 = this->c1, c2 = this->c2;
+    FP      *m = s.m.data(), *v = s.v.data();
+
+    switch (cfg.type) {
+      case OPT_SGD:
+        for_chunks(s.n, [&](size_t lo, size_t hi) {
+#pragma omp simd
+          for (size_t i = lo; i < hi; ++i) w[i] -= lr * (gScale * g[i] + wd * w[i]);
+        });
+        break;
+      case OPT_MOMENTUM:
+        for_chunks(s.n, [&](size_t lo, size_t hi) {
+#pragma omp simd
+          for (size_t i = lo; i < hi; ++i) {
+            m[i]  = mu * m[i] + gScale * g[i] + wd * w[i];
+            w[i] -= lr * m[i];
+          }
+        });
+        break;
+      case OPT_ADAM:
+      case OPT_ADAMW: {
+        const bool decoupled = cfg.type == OPT_ADAMW;
+        const FP   l2 = decoupled ? FP(0) : wd, dw = decoupled ? wd : FP(0);
+        for_chunks(s.n, [&](size_t lo, size_t hi) {
+#pragma omp simd
+          for (size_t i = lo; i < hi; ++i) {
+            const FP gi  = gScale * g[i] + l2 * w[i];
+            m[i]         = b1 * m[i] + (1 - b1) * gi;
+            v[i]         = b2 * v[i] + (1 - b2) * gi * gi;
+            w[i]        -= lr * (m[i] * c1 / (std::sqrt(v[i] * c2) + eps) + dw * w[i]);
+          }
+        });
+        break;
+      }
+    }
+  }
+
+  const OptimizerConfig<FP> &config() const { return cfg; }
+  void                       set_lr(FP lr) { cfg.lr = lr; }
+  size_t                     step() const { return t; }
+  // state kembali nol, misalnya setelah bobot diganti dari file
+  void reset() {
+    t = 0;
+    for (auto &s : slots) {
+      std::fill(s.m.begin(), s.m.end(), FP(0));
+      std::fill(s.v.begin(), s.v.end(), FP(0));
+    }
+  }
+};
+
+}  // namespace NN
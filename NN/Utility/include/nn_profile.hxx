@@ -0,0 +1,71 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+/* Pencatat waktu per layer untuk benchmark. Kalau tidak diaktifkan, time_* cuma
+ * memanggil fungsinya langsung tanpa baca clock, jadi aman dibiarkan di jalur training.
+ * Waktu dijumlah terus sampai reset(), rata-rata per langkah dihitung pemanggil.
+ */
+
+namespace NN {
+
+struct LayerTiming {
+  double forwardMs = 0, backwardMs = 0;
+};
+
+class LayerProfiler {
+  std::vector<LayerTiming> t;
+  bool                     on = false;
+
+  template <typename F>
+  static double elapsed_ms(F &&f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+ public:
+  // mengaktifkan mereset waktu, mematikan membiarkannya supaya bisa dibaca setelah run
+  void enable(size_t layers, bool e = true) {
+    on = e;
+    if (e) t.assign(layers, {});
+  }
+  bool enabled() const { return on; }
+  void reset() { t.assign(t.size(), {}); }
+
+  template <typename F>
+  void time_forward(size_t l, F &&f) {
+    if (on) t[l].forwardMs += elapsed_ms(f);
+    else f();
+  }
+  template <typename F>
+  void time_backward(size_t l, F &&f) {
+    if (on) t[l].backwardMs += elapsed_ms(f);
+    else f();
+  }
+
+  const std::vector<LayerTiming> &timings() const { return t; }
+};
+
+}  // namespace NN
@@ -0,0 +1,217 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <aligned.hxx>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <dense_matrix.hxx>
+#include <functional>
+#include <vector>
+
+#if (defined(__AVX512VNNI__) && defined(__AVX512BW__)) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* Inference int8 untuk FFN yang sudah dilatih.
+ * Bobot dikuantisasi per channel output, simetris (zero point 0):
+ *   w ≈ scale[o] * q,  q ∈ [-127, 127]
+ * Aktivasi dikuantisasi dinamis per sampel, asimetris dengan zero point:
+ *   x ≈ sa * (qa - za),  qa ∈ [0, 127]
+ * Aktivasi sengaja cuma 7 bit supaya pmaddubsw (u8 × s8, dua pasang dijumlah ke
+ * int16 saturasi) tidak pernah saturasi: 2 * 127 * 127 < 32767. Dengan begitu
+ * jalur AVX2, VNNI dan skalar hasilnya sama persis.
+ *
+ *   y[o] = sa * scale[o] * (Σ qa·q - za · Σ q) + b[o]
+ */
+
+namespace NN::quant {
+
+// satu baris bobot int8 dipad ke 64 elemen, satu cache line dan satu register AVX-512
+inline constexpr size_t QROW_ALIGN = Linear::CACHE_LINE;
+
+constexpr size_t pad_row(size_t n) { return (n + QROW_ALIGN - 1) / QROW_ALIGN * QROW_ALIGN; }
+
+/* Σ a[i] * w[i] dengan akumulator int32, n harus kelipatan QROW_ALIGN dan
+ * kedua pointer rata 64 byte (dijamin oleh pad_row + aligned_vector).
+ */
+inline int32_t dot_u8s8(const uint8_t *a, const int8_t *w, size_t n) {
+#if defined(__AVX512VNNI__) && defined(__AVX512BW__)
+  __m512i acc = _mm512_setzero_si512();
+  for (size_t i = 0; i < n; i += 64) acc = _mm512_dpbusd_epi32(acc, _mm512_load_si512(a + i), _mm512_load_si512(w + i));
+  // lewat memori, intrinsic extract/reduce memicu -Wmaybe-uninitialized palsu di gcc 12
+  alignas(64) int32_t lanes[16];
+  _mm512_store_si512(lanes, acc);
+  int32_t sum = 0;
+  for (int32_t v : lanes) sum += v;
+  return sum;
+#elif defined(__AVX2__)
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i       acc  = _mm256_setzero_si256();
+  for (size_t i = 0; i < n; i += 32) {
+    const __m256i p16 = _mm256_maddubs_epi16(_mm256_load_si256(reinterpret_cast<const __m256i *>(a + i)), _mm256_load_si256(reinterpret_cast<const __m256i *>(w + i)));
+    acc               = _mm256_add_epi32(acc, _mm256_madd_epi16(p16, ones));
+  }
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  s         = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+  s         = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(s);
+#else
+  // fallback: compiler biasanya tetap mengeluarkan pmaddwd/vpdpbusd sendiri dari loop ini
+  int32_t sum = 0;
+#pragma omp simd reduction(+ : sum)
+  for (size_t i = 0; i < n; ++i) sum += int32_t(a[i]) * int32_t(w[i]);
+  return sum;
+#endif
+}
+
+template <std::floating_point FP>
+struct QuantizedLayer {
+  size_t                         in = 0, out = 0, stride = 0;
+  Linear::aligned_vector<int8_t> w;       // out × stride, padding 0
+  std::vector<float>             scale;   // per channel output
+  std::vector<int32_t>           rowSum;  // Σ q per baris, untuk koreksi zero point aktivasi
+  std::vector<FP>                b;
+
+  // W berukuran out × in (baris = neuron output), b panjang out
+  QuantizedLayer(Linear::MatrixView<const FP> W, const FP *bias) : in(W.cols()), out(W.rows()), stride(pad_row(W.cols())), w(out * stride, 0), scale(out), rowSum(out), b(bias, bias + out) {
+    for (size_t o = 0; o < out; ++o) {
+      FP maxAbs = 0;
+      for (size_t i = 0; i < in; ++i) maxAbs = std::max(maxAbs, std::abs(W(o, i)));
+      const FP s = maxAbs > 0 ? maxAbs / 127 : FP(1);
+      int32_t  sum = 0;
+      for (size_t i = 0; i < in; ++i) {
+        const int8_t q      = static_cast<int8_t>(std::clamp<long>(std::lround(W(o, i) / s), -127, 127));
+        w[o * stride + i]   = q;
+        sum                += q;
+      }
+      scale[o]  = static_cast<float>(s);
+      rowSum[o] = sum;
+    }
+  }
+};
+
+/* x (n elemen) → qa (7 bit) dengan rentang [min(x, 0), max(x, 0)] supaya 0 tepat
+ * terwakili, @return scale sa, zero point ditulis ke za
+ */
+template <std::floating_point FP>
+inline FP quantize_activations(const FP *x, size_t n, uint8_t *qa, int32_t &za) {
+  FP lo = 0, hi = 0;
+  for (size_t i = 0; i < n; ++i) {
+    lo = std::min(lo, x[i]);
+    hi = std::max(hi, x[i]);
+  }
+  const FP sa = hi > lo ? (hi - lo) / 127 : FP(1);
+  za          = static_cast<int32_t>(std::lround(-lo / sa));
+  const FP inv = 1 / sa;
+#pragma omp simd
+  for (size_t i = 0; i < n; ++i) qa[i] = static_cast<uint8_t>(std::clamp<FP>(std::nearbyint(x[i] * inv) + za, 0, 127));
+  return sa;
+}
+
+/* Model inference int8 hasil export FFN float. Aktivasi per layer berupa fungsi
+ * (kosong = tanpa aktivasi) supaya tidak terikat ke enum aktivasi model mana pun,
+ * dan bisa membawa parameter instance seperti epsilon ReLU. Biayanya satu panggilan
+ * per neuron setelah dot product int8.
+ */
+template <std::floating_point FP>
+class QuantizedFFN {
+ public:
+  using Activation = std::function<FP(FP)>;
+
+ private:
+  std::vector<QuantizedLayer<FP>> layers;
+  std::vector<Activation>         acts;
+  size_t                          maxWidth = 0, maxStride = 0;
+
+  // scratch per thread, sama seperti buffer pack gemm
+  struct Scratch {
+    Linear::aligned_vector<uint8_t> qa;
+    std::vector<FP>                 x, y;
+  };
+  Scratch &scratch() const {
+    thread_local Scratch s;
+    if (s.qa.size() < maxStride) s.qa.assign(maxStride, 0);
+    if (s.x.size() < maxWidth) {
+      s.x.resize(maxWidth);
+      s.y.resize(maxWidth);
+    }
+    return s;
+  }
+
+  static void forward_layer(const QuantizedLayer<FP> &l, const Activation &act, const FP *x, FP *y, uint8_t *qa) {
+    int32_t  za = 0;
+    const FP sa = quantize_activations(x, l.in, qa, za);
+    for (size_t o = 0; o < l.out; ++o) {
+      const int32_t acc = dot_u8s8(qa, l.w.data() + o * l.stride, l.stride) - za * l.rowSum[o];
+      const FP      z   = sa * l.scale[o] * FP(acc) + l.b[o];
+      y[o]              = act ? act(z) : z;
+    }
+  }
+
+ public:
+  QuantizedFFN() = default;
+
+  void add_layer(Linear::MatrixView<const FP> W, const FP *b, Activation act) {
+    layers.emplace_back(W, b);
+    acts.push_back(std::move(act));
+    maxWidth  = std::max({maxWidth, W.rows(), W.cols()});
+    maxStride = std::max(maxStride, layers.back().stride);
+  }
+
+  size_t input_size() const { return layers.empty() ? 0 : layers.front().in; }
+  size_t output_size() const { return layers.empty() ? 0 : layers.back().out; }
+
+  // ukuran bobot + scale + bias dalam byte, untuk dibandingkan dengan model float
+  size_t memory_bytes() const {
+    size_t n = 0;
+    for (const auto &l : layers) n += l.w.size() + l.scale.size() * sizeof(float) + l.rowSum.size() * sizeof(int32_t) + l.b.size() * sizeof(FP);
+    return n;
+  }
+
+  // satu sampel, out minimal output_size() elemen
+  void forward(const FP *in, FP *out) const {
+    Scratch &s   = scratch();
+    const FP *x  = in;
+    FP       *bufs[2] = {s.x.data(), s.y.data()};
+    for (size_t l = 0; l < layers.size(); ++l) {
+      FP *y = l + 1 == layers.size() ? out : bufs[l & 1];
+      forward_layer(layers[l], acts[l], x, y, s.qa.data());
+      x = y;
+    }
+  }
+
+  // X batch × input_size(), Y batch × output_size(), row-major, sampel dibagi ke thread
+  void forward_batch(const FP *X, FP *Y, size_t batch) const {
+#pragma omp parallel for schedule(static) if (batch > 1)
+    for (size_t r = 0; r < batch; ++r) forward(X + r * input_size(), Y + r * output_size());
+  }
+
+  std::vector<FP> predict(const std::vector<FP> &x) const {
+    std::vector<FP> out(output_size());
+    forward(x.data(), out.data());
+    return out;
+  }
+};
+
+}  // namespace NN::quant
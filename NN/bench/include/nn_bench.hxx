@@ -0,0 +1,128 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <nn_profile.hxx>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Struktur bersama benchmark nn_bench. Jaringan yang diukur selalu
+ * INPUT → width → width → OUTPUT supaya BasicFFN (ukuran compile time) dan
+ * NN::FFN bisa dibandingkan langsung. FLOP dan byte di bawah adalah model
+ * perkiraan dari ukuran gemm, bukan hasil counter hardware.
+ */
+
+namespace NN::bench {
+
+inline constexpr size_t INPUT = 32, OUTPUT = 8;
+
+struct BenchConfig {
+  std::vector<size_t> threads, batches, widths;
+  size_t              steps = 20, warmup = 2;
+};
+
+struct LayerReport {
+  size_t in = 0, out = 0;
+  double forwardMs = 0, backwardMs = 0;  // rata-rata per langkah
+  double forwardGflops = 0, backwardGflops = 0, forwardGBs = 0, backwardGBs = 0;
+};
+
+struct BenchResult {
+  std::string              model;
+  size_t                   width = 0, batch = 0, threads = 0;
+  double                   trainSamplesPerSec = 0, inferSamplesPerSec = 0, trainGflops = 0;
+  std::vector<LayerReport> layers;
+};
+
+/* forward: gemm B×in · in×out = 2·B·in·out FLOP, baca W, X dan tulis Y.
+ * backward: gemm gradien bobot 2·B·in·out, ditambah gemm delta 2·B·in·out kecuali
+ * layer pertama (delta input tidak dihitung); W dibaca lalu ditulis lagi.
+ */
+inline LayerReport layer_report(size_t in, size_t out, size_t batch, bool first, size_t fpBytes, const LayerTiming &t, size_t steps) {
+  LayerReport r{.in = in, .out = out, .forwardMs = t.forwardMs / steps, .backwardMs = t.backwardMs / steps};
+  const double w = double(in) * out, x = double(batch) * in, y = double(batch) * out;
+  const double fwdFlop = 2 * batch * w, bwdFlop = first ? fwdFlop : 2 * fwdFlop;
+  const double fwdByte = fpBytes * (w + x + y), bwdByte = fpBytes * (2 * w + x + y + (first ? 0 : w + 2 * x));
+  // ms → s dan FLOP → GFLOP saling menghapus sebagian: x / (ms · 1e6)
+  if (r.forwardMs > 0) r.forwardGflops = fwdFlop / (r.forwardMs * 1e6), r.forwardGBs = fwdByte / (r.forwardMs * 1e6);
+  if (r.backwardMs > 0) r.backwardGflops = bwdFlop / (r.backwardMs * 1e6), r.backwardGBs = bwdByte / (r.backwardMs * 1e6);
+  return r;
+}
+
+inline void set_threads(size_t n) {
+#ifdef _OPENMP
+  omp_set_num_threads(int(n));
+#else
+  (void)n;
+#endif
+}
+
+/* Satu titik sweep untuk net apa pun yang punya train_batch/set_profiling/layer_timings.
+ * Training dan inference diukur terpisah, warmup tidak ikut dihitung.
+ * infer(X, Y, batch) membungkus predict_batch/forward_batch milik masing-masing FFN.
+ */
+template <typename FP, typename Net, typename Infer>
+BenchResult measure(Net &net, Infer &&infer, const std::string &model, size_t width, size_t batch, size_t threads, const BenchConfig &cfg) {
+  std::mt19937                       gen(42);
+  std::uniform_real_distribution<FP> dis(0, 1);
+  std::vector<FP>                    X(batch * INPUT), Y(batch * OUTPUT), out(batch * OUTPUT);
+  for (auto &x : X) x = dis(gen);
+  for (auto &y : Y) y = dis(gen);
+
+  using clock = std::chrono::steady_clock;
+  set_threads(threads);
+  for (size_t s = 0; s < cfg.warmup; ++s) net.train_batch(X.data(), Y.data(), batch);
+
+  net.set_profiling(true);
+  auto start = clock::now();
+  for (size_t s = 0; s < cfg.steps; ++s) net.train_batch(X.data(), Y.data(), batch);
+  const double trainSec = std::chrono::duration<double>(clock::now() - start).count();
+  net.set_profiling(false);
+
+  for (size_t s = 0; s < cfg.warmup; ++s) infer(X.data(), out.data(), batch);
+  start = clock::now();
+  for (size_t s = 0; s < cfg.steps; ++s) infer(X.data(), out.data(), batch);
+  const double inferSec = std::chrono::duration<double>(clock::now() - start).count();
+
+  BenchResult  r{.model = model, .width = width, .batch = batch, .threads = threads, .layers = {}};
+  const size_t sizes[] = {INPUT, width, width, OUTPUT};
+  double       flop    = 0;
+  for (size_t l = 0; l < 3; ++l) {
+    r.layers.push_back(layer_report(sizes[l], sizes[l + 1], batch, l == 0, sizeof(FP), net.layer_timings()[l], cfg.steps));
+    flop += 2.0 * batch * sizes[l] * sizes[l + 1] * (l == 0 ? 2 : 3);
+  }
+  r.trainSamplesPerSec = cfg.steps * batch / trainSec;
+  r.inferSamplesPerSec = cfg.steps * batch / inferSec;
+  r.trainGflops        = flop * cfg.steps / trainSec * 1e-9;
+  return r;
+}
+
+// lebar hidden yang dipakai BasicFFN harus diketahui saat compile
+inline constexpr size_t BASIC_WIDTHS[] = {64, 256, 1024};
+
+std::vector<BenchResult> run_basic(const BenchConfig &cfg);
+
+}  // namespace NN::bench
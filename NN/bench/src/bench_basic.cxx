@@ -0,0 +1,54 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <basicFFN/include/ffn.hxx>
+#include <nn_bench.hxx>
+#include <utility>
+
+namespace NN::bench {
+
+namespace {
+
+template <size_t W>
+void run_width(const BenchConfig &cfg, std::vector<BenchResult> &results) {
+  if (std::find(cfg.widths.begin(), cfg.widths.end(), W) == cfg.widths.end()) return;
+  for (size_t t : cfg.threads)
+    for (size_t b : cfg.batches) {
+      BasicFFN<float, INPUT, W, W, OUTPUT> net(RELU, MSE);
+      results.push_back(measure<float>(net, [&](const float *X, float *Y, size_t n) { net.forward_batch(X, Y, n); }, "BasicFFN", W, b, t, cfg));
+    }
+}
+
+template <size_t... I>
+void run_widths(const BenchConfig &cfg, std::vector<BenchResult> &results, std::index_sequence<I...>) {
+  (run_width<BASIC_WIDTHS[I]>(cfg, results), ...);
+}
+
+}  // namespace
+
+// lebar di cfg.widths yang tidak ada di BASIC_WIDTHS dilewati untuk BasicFFN
+std::vector<BenchResult> run_basic(const BenchConfig &cfg) {
+  std::vector<BenchResult> results;
+  run_widths(cfg, results, std::make_index_sequence<std::size(BASIC_WIDTHS)>{});
+  return results;
+}
+
+}  // namespace NN::bench
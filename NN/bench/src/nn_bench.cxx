@@ -0,0 +1,146 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <dynFFN/include/ffn.hxx>
+#include <fstream>
+#include <iostream>
+#include <nn_bench.hxx>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/* nn_bench: train + inference BasicFFN dan NN::FFN untuk tiap kombinasi
+ * thread × batch × width, hasilnya JSON (stdout atau --out file).
+ * Contoh: nn_bench -t 1,4 -b 32,256 -w 64,256 -s 50 -o bench.json
+ */
+
+using namespace NN::bench;
+
+namespace {
+
+void printHelp() {
+  std::cout << "Usage: nn_bench [options]\n"
+               "  -t, --threads <list>  OpenMP thread counts, e.g. 1,4 (default: 1,hw)\n"
+               "  -b, --batch <list>    batch sizes (default: 32,256)\n"
+               "  -w, --width <list>    hidden widths (default: 64,256,1024)\n"
+               "  -s, --steps <n>       measured steps per point (default: 20)\n"
+               "  -o, --out <file>      write JSON to file instead of stdout\n"
+               "  --no-basic            skip BasicFFN (only widths 64, 256, 1024 exist)\n"
+               "  -h, --help            show this help\n";
+}
+
+std::vector<size_t> parse_list(const std::string &s) {
+  std::vector<size_t> v;
+  std::stringstream   ss(s);
+  for (std::string item; std::getline(ss, item, ',');)
+    if (!item.empty()) v.push_back(std::stoul(item));
+  if (v.empty()) throw std::invalid_argument("empty list: '" + s + "'");
+  return v;
+}
+
+std::vector<BenchResult> run_dyn(const BenchConfig &cfg) {
+  using NN::ACTIVATION_TYPE;
+  std::vector<BenchResult> results;
+  for (size_t w : cfg.widths)
+    for (size_t t : cfg.threads)
+      for (size_t b : cfg.batches) {
+        // aktivasi disamakan dengan BasicFFN: layer input → hidden1 tanpa aktivasi
+        NN::FFN<float> net({{INPUT, ACTIVATION_TYPE::NONE}, {w, ACTIVATION_TYPE::NONE}, {w, ACTIVATION_TYPE::ReLU}, {OUTPUT, ACTIVATION_TYPE::ReLU}});
+        results.push_back(measure<float>(net, [&](const float *X, float *Y, size_t n) { net.predict_batch(X, Y, n); }, "FFN", w, b, t, cfg));
+      }
+  return results;
+}
+
+void write_json(std::ostream &os, const BenchConfig &cfg, const std::vector<BenchResult> &results) {
+  os << "{\n  \"input\": " << INPUT << ",\n  \"output\": " << OUTPUT << ",\n  \"steps\": " << cfg.steps << ",\n  \"fp_bytes\": " << sizeof(float)
+     << ",\n  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult &r = results[i];
+    os << (i ? "," : "") << "\n    {\"model\": \"" << r.model << "\", \"width\": " << r.width << ", \"batch\": " << r.batch << ", \"threads\": " << r.threads
+       << ", \"train_samples_per_sec\": " << r.trainSamplesPerSec << ", \"infer_samples_per_sec\": " << r.inferSamplesPerSec
+       << ", \"train_gflops\": " << r.trainGflops << ",\n     \"layers\": [";
+    for (size_t l = 0; l < r.layers.size(); ++l) {
+      const LayerReport &L = r.layers[l];
+      os << (l ? "," : "") << "\n       {\"in\": " << L.in << ", \"out\": " << L.out << ", \"forward_ms\": " << L.forwardMs << ", \"backward_ms\": " << L.backwardMs
+         << ", \"forward_gflops\": " << L.forwardGflops << ", \"backward_gflops\": " << L.backwardGflops << ", \"forward_gbps\": " << L.forwardGBs
+         << ", \"backward_gbps\": " << L.backwardGBs << "}";
+    }
+    os << "]}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  using namespace std;
+
+  const size_t hw = max(1u, thread::hardware_concurrency());
+  BenchConfig  cfg{.threads = hw > 1 ? vector<size_t>{1, hw} : vector<size_t>{1}, .batches = {32, 256}, .widths = {64, 256, 1024}};
+  string       out_file;
+  bool         basic = true;
+
+  try {
+    for (int i = 1; i < argc; i++) {
+      string arg = argv[i];
+      if (arg == "-h" || arg == "--help") {
+        printHelp();
+        return 0;
+      }
+      if (arg == "--no-basic") {
+        basic = false;
+        continue;
+      }
+      if (i + 1 >= argc) {
+        cerr << "Error: Missing argument for " << arg << " option" << endl;
+        return 1;
+      }
+      string val = argv[++i];
+      if (arg == "-t" || arg == "--threads") cfg.threads = parse_list(val);
+      else if (arg == "-b" || arg == "--batch") cfg.batches = parse_list(val);
+      else if (arg == "-w" || arg == "--width") cfg.widths = parse_list(val);
+      else if (arg == "-s" || arg == "--steps") cfg.steps = stoul(val);
+      else if (arg == "-o" || arg == "--out") out_file = val;
+      else {
+        cerr << "Error: Unknown option " << arg << endl;
+        printHelp();
+        return 1;
+      }
+    }
+  } catch (const exception &e) {
+    cerr << "Error: " << e.what() << endl;
+    return 1;
+  }
+  if (!cfg.steps) cfg.steps = 1;
+
+  vector<BenchResult> results = basic ? run_basic(cfg) : vector<BenchResult>{};
+  for (auto &r : run_dyn(cfg)) results.push_back(std::move(r));
+
+  if (out_file.empty()) write_json(cout, cfg, results);
+  else {
+    ofstream ofs(out_file);
+    if (!ofs) {
+      cerr << "Error: Failed to open '" << out_file << "' for writing" << endl;
+      return 1;
+    }
+    write_json(ofs, cfg, results);
+  }
+  return 0;
+}
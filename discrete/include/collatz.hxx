@@ -0,0 +1,238 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Mesin Collatz untuk range besar.
+ * Dipakai bentuk shortcut T(n) = n/2 (genap) atau (3n+1)/2 (ganjil). Untuk
+ * n = a·2^K + b, K langkah T sekaligus adalah T^K(n) = a·3^c(b) + T^K(b) dengan
+ * c(b) = banyak langkah ganjil dari b, jadi cukup tabel 2^K entri (c, T^K(b)).
+ * Langkah standar (3n+1 dan n/2 dihitung terpisah) per lompatan = K + c.
+ * Lompatan dipakai selama n >= memo.size() (>= 2^K, jadi 1 tidak mungkin terlewati
+ * di tengah lompatan), sisanya diambil dari memo total stopping time n < memo.size().
+ * Nilai antara 128 bit dan tiap perkalian/penjumlahan dicek overflow.
+ */
+
+namespace Discrete {
+class Collatz {
+ public:
+  using u128 = unsigned __int128;
+
+  struct Trajectory {
+    uint64_t steps = 0, oddSteps = 0;  // total stopping time dan banyak langkah 3n+1
+    u128     peak  = 0;
+  };
+
+  struct RangeStats {
+    uint64_t              first = 0, count = 0;
+    uint64_t              maxSteps = 0, argMax = 0;
+    double                meanSteps = 0;
+    std::vector<uint64_t> histogram;  // histogram[s] = banyak seed dengan total stopping time s
+  };
+
+ private:
+  static constexpr unsigned K = 16;
+  static constexpr uint64_t MASK = (uint64_t(1) << K) - 1;
+
+  std::vector<uint8_t>  jumpC;
+  std::vector<uint32_t> jumpD;
+  uint64_t              pow3[K + 1];
+  std::vector<uint16_t> memo;
+  int                   maxThread = std::max(1u, std::thread::hardware_concurrency());
+
+  static u128 checked_mul_add(u128 a, uint64_t m, uint64_t d) {
+    u128 r;
+    if (__builtin_mul_overflow(a, u128(m), &r) || __builtin_add_overflow(r, u128(d), &r)) throw std::overflow_error("Collatz: trajectory exceeds 128 bit");
+    return r;
+  }
+
+  void build_tables() {
+    pow3[0] = 1;
+    for (unsigned i = 1; i <= K; ++i) pow3[i] = pow3[i - 1] * 3;
+    jumpC.resize(size_t(1) << K);
+    jumpD.resize(size_t(1) << K);
+    for (uint64_t b = 0; b <= MASK; ++b) {
+      uint64_t n = b, c = 0;
+      for (unsigned i = 0; i < K; ++i) {
+        if (n & 1) n = (3 * n + 1) >> 1, ++c;
+        else n >>= 1;
+      }
+      jumpC[b] = uint8_t(c);
+      jumpD[b] = uint32_t(n);
+    }
+  }
+
+  // memo[n] dibangun naik: jalan dari n sampai turun di bawah n, sisanya sudah ada di memo
+  void build_memo(size_t size) {
+    memo.assign(size, 0);
+    for (uint64_t n = 2; n < size; ++n) {
+      u128     m     = n;
+      uint64_t steps = 0;
+      while (m >= n) {
+        m = (m & 1) ? checked_mul_add(m, 3, 1) : m >> 1;
+        ++steps;
+      }
+      memo[n] = uint16_t(steps + memo[uint64_t(m)]);
+    }
+  }
+
+  /* f(begin, end, tid) untuk potongan [begin, end) dari [0, count), potongan
+   * dibagi dinamis ke maxThread thread lewat counter atomik seperti sieve Prime.
+   * Exception dari f (mis. overflow_error) ditangkap per worker, pembagian potongan
+   * dihentikan, semua thread di-join, lalu exception pertama dilempar ulang di sini.
+   */
+  template <typename F>
+  void parallel_chunks(uint64_t count, F &&f, uint64_t chunk = uint64_t(1) << 16) const {
+    std::atomic<uint64_t> next   = 0;
+    std::atomic<bool>     failed = false;
+    std::exception_ptr    error;
+    std::mutex            errorMtx;
+    auto                  fail = [&](std::exception_ptr e) {
+      std::lock_guard<std::mutex> lock(errorMtx);
+      if (!error) error = e;
+      failed.store(true, std::memory_order_relaxed);
+    };
+    auto worker = [&](int tid) {
+      try {
+        for (uint64_t b; !failed.load(std::memory_order_relaxed) && (b = next.fetch_add(chunk, std::memory_order_relaxed)) < count;)
+          f(b, b + std::min(chunk, count - b), tid);
+      } catch (...) {
+        fail(std::current_exception());
+      }
+    };
+    const int                n = int(std::min<uint64_t>(maxThread, (count + chunk - 1) / chunk));
+    std::vector<std::thread> threads;
+    try {
+      for (int i = 1; i < n; ++i) threads.emplace_back(worker, i);
+    } catch (...) {
+      fail(std::current_exception());  // gagal membuat thread: hentikan yang sudah jalan
+    }
+    worker(0);
+    for (auto &t : threads) t.join();
+    if (error) std::rethrow_exception(error);
+  }
+
+ public:
+  /* memoSize = banyak total stopping time yang disimpan (uint16, default 2^24 = 32 MiB),
+   * minimal 2^K dan maksimal 2^32
+   */
+  explicit Collatz(size_t memoSize = size_t(1) << 24) {
+    if (memoSize < (size_t(1) << K) || memoSize > (size_t(1) << 32)) throw std::invalid_argument("Collatz: memo size must be within [2^16, 2^32]");
+    build_tables();
+    build_memo(memoSize);
+  }
+
+  void set_max_thread(int n) { maxThread = n > 0 ? n : std::max(1u, std::thread::hardware_concurrency()); }
+  int  max_thread() const noexcept { return maxThread; }
+
+  // banyak langkah standar sampai 1, @throw std::overflow_error kalau nilai antara > 128 bit
+  uint64_t total_stopping_time(uint64_t seed) const {
+    if (!seed) throw std::invalid_argument("Collatz: seed must be positive");
+    u128     n     = seed;
+    uint64_t steps = 0;
+    while (n >= memo.size()) {
+      const uint64_t b = uint64_t(n) & MASK, c = jumpC[b];
+      n                = checked_mul_add(n >> K, pow3[c], jumpD[b]);
+      steps           += K + c;
+    }
+    return steps + memo[uint64_t(n)];
+  }
+
+  // jalan langkah demi langkah untuk satu seed, dipakai kalau butuh puncak lintasan
+  static Trajectory trajectory(uint64_t seed) {
+    if (!seed) throw std::invalid_argument("Collatz: seed must be positive");
+    Trajectory t;
+    u128       n = seed;
+    t.peak       = n;
+    while (n != 1) {
+      if (n & 1) n = checked_mul_add(n, 3, 1), ++t.oddSteps;
+      else n >>= 1;
+      ++t.steps;
+      if (n > t.peak) t.peak = n;
+    }
+    return t;
+  }
+
+  // out[i] = total stopping time seed first + i, dihitung paralel
+  void stopping_times(uint64_t first, uint64_t count, uint32_t *out) const {
+    if (!first) throw std::invalid_argument("Collatz: seed must be positive");
+    // first ≥ 1, jadi batas atas dihitung tanpa overflow dan seed terakhir boleh tepat 2^64 - 1
+    if (count > UINT64_MAX - first + 1) throw std::overflow_error("Collatz: range exceeds 64 bit seeds");
+    parallel_chunks(count, [&](uint64_t b, uint64_t e, int) {
+      for (uint64_t i = b; i < e; ++i) out[i] = uint32_t(total_stopping_time(first + i));
+    });
+  }
+
+  // statistik total stopping time untuk seed [first, first + count), tanpa menyimpan hasil per seed
+  RangeStats range(uint64_t first, uint64_t count) const {
+    if (!first) throw std::invalid_argument("Collatz: seed must be positive");
+    // first ≥ 1, jadi batas atas dihitung tanpa overflow dan seed terakhir boleh tepat 2^64 - 1
+    if (count > UINT64_MAX - first + 1) throw std::overflow_error("Collatz: range exceeds 64 bit seeds");
+    struct Local {
+      uint64_t              maxSteps = 0, argMax = UINT64_MAX;
+      long double           sum      = 0;
+      std::vector<uint64_t> histogram;
+    };
+    std::vector<Local> local(maxThread);
+    parallel_chunks(count, [&](uint64_t b, uint64_t e, int tid) {
+      Local   &l   = local[tid];
+      uint64_t sum = 0;
+      for (uint64_t i = b; i < e; ++i) {
+        const uint64_t seed = first + i, s = total_stopping_time(seed);
+        if (s >= l.histogram.size()) l.histogram.resize(s + 1);
+        ++l.histogram[s];
+        sum += s;
+        // seed terkecil menang kalau sama panjang, supaya hasil tidak tergantung jadwal thread
+        if (s > l.maxSteps || (s == l.maxSteps && seed < l.argMax)) l.maxSteps = s, l.argMax = seed;
+      }
+      l.sum += sum;
+    });
+
+    RangeStats  r{.first = first, .count = count, .argMax = UINT64_MAX, .histogram = {}};
+    long double sum = 0;
+    for (const Local &l : local) {
+      if (l.histogram.size() > r.histogram.size()) r.histogram.resize(l.histogram.size());
+      for (size_t s = 0; s < l.histogram.size(); ++s) r.histogram[s] += l.histogram[s];
+      if (l.maxSteps > r.maxSteps || (l.maxSteps == r.maxSteps && l.argMax < r.argMax)) r.maxSteps = l.maxSteps, r.argMax = l.argMax;
+      sum += l.sum;
+    }
+    if (!count) r.argMax = 0;
+    r.meanSteps = count ? double(sum / count) : 0;
+    return r;
+  }
+
+  static std::string to_string(u128 v) {
+    if (!v) return "0";
+    std::string s;
+    for (; v; v /= 10) s.insert(s.begin(), char('0' + int(v % 10)));
+    return s;
+  }
+};
+}  // namespace Discrete
@@ -19,14 +19,17 @@
 
 #pragma once
 
+#include <atomic>
 #include "bit.hxx"
 #include <cmath>
 #include <concepts>
 #include <cstdint>
 #include <cstdlib>
+#include <exception>
 #include <fstream>
 #include "heap.hxx"
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -168,6 +171,71 @@ requires((std::integral<T> || std::floating_point<T>) && !std::is_same_v<bool, T
     return primes;
   }
 
+  /* Segmented sieve untuk limit yang terlalu besar disimpan utuh: [2, limit] dipecah
+   * jadi segmen segmentSpan angka (default 2^21, bitset ganjilnya 128 KiB muat di L2),
+   * tiap segmen disaring pakai prima dasar <= sqrt(limit) lalu primanya dioper ke
+   * f(tid, primes, count) tanpa menyimpan semuanya. Segmen dibagi dinamis ke maxThread
+   * thread, jadi f dipanggil paralel (tid 0..maxThread-1) dan urutan segmennya acak.
+   * Exception dari f menghentikan pembagian segmen, semua thread di-join, lalu
+   * exception pertama dilempar ulang ke pemanggil.
+   */
+  template <typename F>
+  void for_each_segment(T limit, F &&f, size_t segmentSpan = size_t(1) << 21) {
+    using namespace std;
+    if (limit < 2) return;
+    segmentSpan               = (segmentSpan + 127) & ~size_t(127);
+    const vector<T> base      = from_range_limit(static_cast<T>(sqrt(double(limit))) + 1);
+    const size_t    segments  = (size_t(limit) + segmentSpan) / segmentSpan;  // segmen k = [k·span, (k+1)·span)
+    atomic<size_t>  next      = 0;
+    atomic<bool>    failed    = false;
+    exception_ptr   error;
+    mutex           errorMtx;
+
+    auto fail = [&](exception_ptr e) {
+      lock_guard<mutex> lock(errorMtx);
+      if (!error) error = e;
+      failed.store(true, memory_order_relaxed);
+    };
+    auto worker = [&](int tid) {
+      try {
+        vector<uint64_t> bits(segmentSpan / 128);
+        vector<T>        primes;
+        for (size_t k; !failed.load(memory_order_relaxed) && (k = next.fetch_add(1, memory_order_relaxed)) < segments;) {
+          const T lo = T(k * segmentSpan), hi = T(std::min<size_t>((k + 1) * segmentSpan, size_t(limit) + 1));
+          // bit i = angka ganjil lo + 2i + 1
+          fill(bits.begin(), bits.end(), ~uint64_t(0));
+          for (T p : base) {
+            if (p == 2) continue;
+            if (p * p >= hi) break;
+            T j = std::max(p * p, (lo + p - 1) / p * p);
+            if (!(j & 1)) j += p;
+            for (; j < hi; j += 2 * p) bits[(j - lo) >> 7] &= ~(1ULL << (((j - lo) >> 1) & 63));
+          }
+          primes.clear();
+          if (lo <= 2 && 2 < hi) primes.push_back(2);
+          for (size_t w = 0; w < bits.size(); ++w)
+            for (uint64_t m = bits[w]; m; m &= m - 1) {
+              const T n = lo + T(((w << 6) + countr_zero(m)) * 2 + 1);
+              if (n >= hi) break;
+              if (n > 1) primes.push_back(n);
+            }
+          if (!primes.empty()) f(tid, primes.data(), primes.size());
+        }
+      } catch (...) {
+        fail(current_exception());
+      }
+    };
+    vector<std::thread> threads;
+    try {
+      for (int i = 1; i < maxThread; ++i) threads.emplace_back(worker, i);
+    } catch (...) {
+      fail(current_exception());  // gagal membuat thread: hentikan yang sudah jalan
+    }
+    worker(0);
+    for (auto &t : threads) t.join();
+    if (error) rethrow_exception(error);
+  }
+
   bool is_prime(T n) {
     if (n <= 1) return false;
     if (n == 2) return true;
@@ -0,0 +1,129 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cctype>
+#include <chrono>
+#include <collatz.hxx>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+uint64_t to_number_with_suffix(const char *str) {
+  using namespace std;
+  size_t   len = strlen(str);
+  uint64_t num = 0;
+
+  for (size_t i = 0; i < len; ++i) {
+    char c = str[i];
+    if (c >= '0' && c <= '9') num = num * 10 + (c - '0');
+    else {
+      char suffix = tolower(str[i]);
+      switch (suffix) {
+        case 'k': return num << 10;
+        case 'm': return num << 20;
+        case 'g': return num << 30;
+        case 't': return num << 40;
+        case 'p': return num << 50;
+        case 'e': return num << 60;
+        default: cerr << "Invalid suffix: " << str[i] << endl; exit(1);
+      }
+    }
+  }
+  return num;
+}
+
+void printHelp() {
+  using namespace std;
+  cout << "Collatz total stopping time" << endl;
+  cout << "\t-h --help\t\tprint this help" << endl;
+  cout << "\t-n --seed <number>\tprint stopping time, odd steps and peak of one seed" << endl;
+  cout << "\t-r --range <count>\tstatistics for seeds [first, first + count) (supports K/M/G)" << endl;
+  cout << "\t-f --first <number>\tfirst seed for -r, default 1" << endl;
+  cout << "\t-t --threads <number>\tworker threads, default all cores" << endl;
+}
+
+void do_n(uint64_t seed) {
+  using namespace std;
+  using namespace Discrete;
+  const auto t = Collatz::trajectory(seed);
+  cout << seed << ": " << t.steps << " steps, " << t.oddSteps << " odd steps, peak " << Collatz::to_string(t.peak) << endl;
+}
+
+void do_r(uint64_t first, uint64_t count, int threads) {
+  using namespace std;
+  using namespace Discrete;
+  Collatz collatz;
+  collatz.set_max_thread(threads);
+  const auto start = chrono::steady_clock::now();
+  const auto r     = collatz.range(first, count);
+  const auto ms    = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+  // ditulis inklusif, first + count bisa tepat 2^64 dan wrap ke 0
+  if (r.count) cout << "seeds [" << r.first << ", " << r.first + (r.count - 1) << "]" << endl;
+  cout << "max stopping time " << r.maxSteps << " at " << r.argMax << endl;
+  cout << "mean stopping time " << r.meanSteps << endl;
+  cout << "computed in " << ms << " ms using " << collatz.max_thread() << " threads (" << (ms > 0 ? r.count / ms * 1e-3 : 0) << " M seeds/s)" << endl;
+}
+
+int main(int argc, char *argv[]) {
+  using namespace std;
+
+  if (argc == 1) {
+    printHelp();
+    return 0;
+  }
+
+  uint64_t seed = 0, count = 0, first = 1;
+  int      threads = 0;
+  bool     do_seed = false, do_range = false;
+
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg == "-h" || arg == "--help") {
+      printHelp();
+      return 0;
+    }
+    if (i + 1 >= argc) {
+      cerr << "Error: Missing argument for " << arg << " option" << endl;
+      return 1;
+    }
+    if (arg == "-n" || arg == "--seed") seed = to_number_with_suffix(argv[++i]), do_seed = true;
+    else if (arg == "-r" || arg == "--range") count = to_number_with_suffix(argv[++i]), do_range = true;
+    else if (arg == "-f" || arg == "--first") first = to_number_with_suffix(argv[++i]);
+    else if (arg == "-t" || arg == "--threads") threads = int(to_number_with_suffix(argv[++i]));
+    else {
+      cerr << "Error: Unknown option " << arg << endl;
+      printHelp();
+      return 1;
+    }
+  }
+
+  try {
+    if (do_seed) do_n(seed);
+    if (do_range) do_r(first, count, threads);
+    if (!do_seed && !do_range) {
+      printHelp();
+      return 1;
+    }
+  } catch (const exception &e) {
+    cerr << "Error: " << e.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -20,10 +20,19 @@
 #pragma once
 
 #include <png.h>
+#include <zlib.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
+#include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 class PNG {
  private:
@@ -32,9 +41,29 @@ class PNG {
   std::ofstream         output;
   png_structp           pngPtr     = nullptr;
   png_infop             infoPtr    = nullptr;
+  bool                  pngReading = false;  // pngPtr dibuat sebagai read struct atau write struct
   int                   imageWidth = 0, imageHeight = 0;
   png_byte              imageColorType = 0, imageBitDepth = 8;
   std::vector<png_byte> imageBuffer;
+  int                   encodeThreads    = 1;  // 1 = libpng, 0 = semua core, n > 1 = encoder band paralel
+  int                   compressionLevel = Z_DEFAULT_COMPRESSION;
+
+  // state selama begin_write() .. end_write()
+  struct WriteStream {
+    size_t                rowBytes = 0, bpp = 1, bandRows = 1, dictRows = 0, chunkRows = 1;
+    size_t                row = 0, encodedRow = 0, windowRow = 0;
+    int                   threads   = 1;
+    long                  bandIndex = 0;
+    uLong                 adler     = 0;
+    bool                  ok        = false;
+    png_byte              zhead[2]  = {};
+    // baris [windowRow, row): ekor yang sudah di-encode (buat filter/dictionary) + baris yang belum
+    std::vector<png_byte> window;
+  } ws;
+
+  // state selama begin_read() .. baris terakhir
+  std::vector<png_byte> readRow;
+  size_t                readRowIndex = 0;
 
   static void png_write_callback(png_structp png, png_bytep data, png_size_t length) {
     auto stream = reinterpret_cast<std::ostream *>(png_get_io_ptr(png));
@@ -48,6 +77,190 @@ class PNG {
     if (!*stream) png_error(png, "READ Error");
   }
 
+  void release() {
+    if (pngPtr) {
+      if (pngReading) png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
+      else png_destroy_write_struct(&pngPtr, &infoPtr);
+    }
+    pngPtr  = nullptr;
+    infoPtr = nullptr;
+  }
+
+  /* ==== encoder band paralel (gaya pigz) ====
+   * Baris dipecah jadi band ~256 KiB, tiap band difilter lalu di-deflate sendiri
+   * sebagai raw deflate yang diakhiri Z_FULL_FLUSH (band terakhir Z_FINISH), jadi
+   * hasilnya bisa disambung jadi satu stream zlib: header 2 byte + semua band +
+   * adler32 gabungan (adler32_combine). 32 KiB terakhir band sebelumnya dipasang
+   * sebagai dictionary supaya rasio kompresi hampir sama dengan stream tunggal.
+   * Filter dipilih per baris (jumlah |byte| terkecil, heuristik libpng). Baris
+   * dibaca dari base (baris pertamanya baseRow), bisa imageBuffer utuh atau window
+   * streaming yang menyimpan dictRows + 1 baris sebelum band.
+   */
+  static constexpr size_t BAND_BYTES = 256 << 10, DICT_BYTES = 32 << 10;
+
+  static png_byte paeth(int a, int b, int c) {
+    const int p = a + b - c, pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    return png_byte(pa <= pb && pa <= pc ? a : pb <= pc ? b : c);
+  }
+
+  // tulis satu baris terfilter (byte tipe filter + data) ke out, prev = nullptr untuk baris 0
+  static void filter_row(const png_byte *cur, const png_byte *prev, size_t n, size_t bpp, png_byte *out, png_byte *trial) {
+    size_t best = SIZE_MAX;
+    for (int f = 0; f < 5; ++f) {
+      png_byte *t   = trial + f * n;
+      size_t    sum = 0;
+      for (size_t i = 0; i < n; ++i) {
+        const int a = i >= bpp ? cur[i - bpp] : 0, b = prev ? prev[i] : 0, c = i >= bpp && prev ? prev[i - bpp] : 0;
+        png_byte  v;
+        switch (f) {
+          case 0: v = cur[i]; break;
+          case 1: v = png_byte(cur[i] - a); break;
+          case 2: v = png_byte(cur[i] - b); break;
+          case 3: v = png_byte(cur[i] - ((a + b) >> 1)); break;
+          default: v = png_byte(cur[i] - paeth(a, b, c)); break;
+        }
+        t[i]  = v;
+        sum  += std::abs(int(int8_t(v)));
+      }
+      if (sum < best) {
+        best   = sum;
+        out[0] = png_byte(f);
+        std::copy_n(t, n, out + 1);
+      }
+    }
+  }
+
+  void filter_rows(const png_byte *base, size_t baseRow, size_t y0, size_t y1, png_byte *out, std::vector<png_byte> &trial) const {
+    const size_t n = ws.rowBytes;
+    for (size_t y = y0; y < y1; ++y, out += n + 1)
+      filter_row(base + (y - baseRow) * n, y ? base + (y - 1 - baseRow) * n : nullptr, n, ws.bpp, out, trial.data());
+  }
+
+  struct Band {
+    std::vector<png_byte> raw, z, dict, trial;
+    uLong                 adler = 0;
+    bool                  ok    = false;
+  };
+
+  void deflate_band(Band &band, const png_byte *base, size_t baseRow, size_t y0, size_t y1, bool last) const {
+    const size_t n = ws.rowBytes;
+    band.ok        = false;
+    band.trial.resize(5 * n);
+    band.raw.resize((y1 - y0) * (n + 1));
+    filter_rows(base, baseRow, y0, y1, band.raw.data(), band.trial);
+    band.adler = adler32(adler32(0, nullptr, 0), band.raw.data(), uInt(band.raw.size()));
+
+    z_stream zs{};
+    if (deflateInit2(&zs, compressionLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) return;
+    if (y0) {
+      // filter ulang ekor band sebelumnya, hasilnya identik dengan yang di-deflate thread lain
+      const size_t dictRows = std::min(y0, ws.dictRows);
+      band.dict.resize(dictRows * (n + 1));
+      filter_rows(base, baseRow, y0 - dictRows, y0, band.dict.data(), band.trial);
+      const size_t len = std::min(band.dict.size(), DICT_BYTES);
+      deflateSetDictionary(&zs, band.dict.data() + band.dict.size() - len, uInt(len));
+    }
+    band.z.resize(deflateBound(&zs, uLong(band.raw.size())) + 16);
+    zs.next_in   = band.raw.data();
+    zs.avail_in  = uInt(band.raw.size());
+    zs.next_out  = band.z.data();
+    zs.avail_out = uInt(band.z.size());
+    const int rc = deflate(&zs, last ? Z_FINISH : Z_FULL_FLUSH);
+    band.ok      = (last ? rc == Z_STREAM_END : rc == Z_OK) && zs.avail_in == 0;
+    band.z.resize(zs.total_out);
+    deflateEnd(&zs);
+  }
+
+  static void put_u32(png_byte *p, uint32_t v) {
+    p[0] = png_byte(v >> 24);
+    p[1] = png_byte(v >> 16);
+    p[2] = png_byte(v >> 8);
+    p[3] = png_byte(v);
+  }
+
+  void write_chunk(const char *type, const png_byte *data, size_t len) {
+    png_byte head[8];
+    put_u32(head, uint32_t(len));
+    std::copy_n(type, 4, head + 4);
+    uLong crc = crc32(crc32(0, nullptr, 0), head + 4, 4);
+    if (len) crc = crc32(crc, data, uInt(len));
+    png_byte tail[4];
+    put_u32(tail, uint32_t(crc));
+    output.write(reinterpret_cast<const char *>(head), 8);
+    output.write(reinterpret_cast<const char *>(data), len);
+    output.write(reinterpret_cast<const char *>(tail), 4);
+  }
+
+  void begin_parallel() {
+    static const png_byte signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    output.write(reinterpret_cast<const char *>(signature), 8);
+
+    png_byte ihdr[13] = {};
+    put_u32(ihdr, uint32_t(imageWidth));
+    put_u32(ihdr + 4, uint32_t(imageHeight));
+    ihdr[8] = imageBitDepth;
+    ihdr[9] = imageColorType;
+    write_chunk("IHDR", ihdr, sizeof(ihdr));
+
+#ifdef _OPENMP
+    ws.threads = encodeThreads > 0 ? encodeThreads : omp_get_max_threads();
+#endif
+    const size_t height = size_t(imageHeight), n = ws.rowBytes;
+    // minimal 4 band per thread supaya gambar kecil pun terbagi rata
+    ws.bandRows  = std::max<size_t>(1, std::min(BAND_BYTES / (n + 1), (height + 4 * ws.threads - 1) / (4 * ws.threads)));
+    ws.chunkRows = ws.bandRows * 4 * ws.threads;
+    ws.dictRows  = (DICT_BYTES + n) / (n + 1);
+
+    // header zlib: CM = 8 (deflate), window 32K, FLEVEL mengikuti level, FCHECK supaya kelipatan 31
+    const int level = compressionLevel == Z_DEFAULT_COMPRESSION ? 6 : compressionLevel;
+    ws.zhead[0]     = 0x78;
+    ws.zhead[1]     = png_byte((level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3) << 6);
+    ws.zhead[1]    += png_byte(31 - (ws.zhead[0] * 256 + ws.zhead[1]) % 31);
+  }
+
+  // encode baris [y0, y1) (kelipatan bandRows kecuali di ujung gambar) jadi IDAT
+  void encode_rows(const png_byte *base, size_t baseRow, size_t y0, size_t y1) {
+    const size_t height = size_t(imageHeight);
+    const long   bands  = long((y1 - y0 + ws.bandRows - 1) / ws.bandRows);
+    Band         band;
+    // band dikompres paralel, bagian ordered menulis IDAT berurutan jadi memori tetap terbatas
+#pragma omp parallel for ordered schedule(dynamic, 1) num_threads(ws.threads) firstprivate(band)
+    for (long i = 0; i < bands; ++i) {
+      const size_t b0 = y0 + size_t(i) * ws.bandRows, b1 = std::min(y1, b0 + ws.bandRows);
+      deflate_band(band, base, baseRow, b0, b1, b1 == height);
+#pragma omp ordered
+      {
+        ws.ok    = ws.ok && band.ok;
+        ws.adler = ws.bandIndex ? adler32_combine(ws.adler, band.adler, z_off_t(band.raw.size())) : band.adler;
+        if (ws.bandIndex++ == 0) band.z.insert(band.z.begin(), ws.zhead, ws.zhead + 2);
+        if (b1 == height) {
+          band.z.resize(band.z.size() + 4);
+          put_u32(band.z.data() + band.z.size() - 4, uint32_t(ws.adler));
+        }
+        if (ws.ok) write_chunk("IDAT", band.z.data(), band.z.size());
+      }
+    }
+    ws.encodedRow = y1;
+  }
+
+  // encode isi window lalu sisakan dictRows + 1 baris terakhir untuk band berikutnya
+  void flush_window() {
+    const size_t n = ws.rowBytes;
+    encode_rows(ws.window.data(), ws.windowRow, ws.encodedRow, ws.row);
+    const size_t keep = std::min(ws.dictRows + 1, ws.row - ws.windowRow);
+    std::copy(ws.window.end() - keep * n, ws.window.end(), ws.window.begin());
+    ws.window.resize(keep * n);
+    ws.windowRow = ws.row - keep;
+  }
+
+  // setjmp dipisah ke fungsi sendiri supaya tidak ada variabel lokal yang bisa ter-clobber longjmp
+  bool write_rows_libpng(const png_byte *rows, size_t count) {
+    if (setjmp(png_jmpbuf(pngPtr))) return ws.ok = false;
+    for (size_t i = 0; i < count; ++i) png_write_row(pngPtr, rows + i * ws.rowBytes);
+    ws.row += count;
+    return true;
+  }
+
   int get_channel_count() const {
     switch (imageColorType) {
       case PNG_COLOR_TYPE_GRAY: return 1;
@@ -61,18 +274,16 @@ class PNG {
  public:
   PNG(std::string fileName) : fileName(fileName) {}
 
-  ~PNG() {
-    if (pngPtr) {
-      if (input.is_open()) png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
-      if (output.is_open()) png_destroy_write_struct(&pngPtr, &infoPtr);
-    }
-  }
+  ~PNG() { release(); }
 
   bool read() {
+    release();
+    if (input.is_open()) input.close();
     input.open(fileName, std::ios::binary);
     if (!input) return false;
 
-    pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    pngPtr     = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    pngReading = true;
     if (!pngPtr) return false;
     infoPtr = png_create_info_struct(pngPtr);
     if (!infoPtr || setjmp(png_jmpbuf(pngPtr))) return false;
@@ -87,7 +298,7 @@ class PNG {
 
     png_read_update_info(pngPtr, infoPtr);
 
-    int rowBytes = png_get_rowbytes(pngPtr, infoPtr);
+    size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
     imageBuffer.resize(imageHeight * rowBytes);
     std::vector<png_bytep> rows(imageHeight);
     for (int y = 0; y < imageHeight; y++) rows[y] = &imageBuffer[y * rowBytes];
@@ -97,35 +308,165 @@ class PNG {
   }
 
   bool write() {
-    if (pngPtr && infoPtr) {
-      png_destroy_write_struct(&pngPtr, &infoPtr);
-      pngPtr  = nullptr;
-      infoPtr = nullptr;
+    const size_t rowBytes = get_row_bytes();
+    if (imageBuffer.size() != imageHeight * rowBytes) imageBuffer.resize(imageHeight * rowBytes);
+    if (!begin_write()) return false;
+    if (encodeThreads == 1) write_rows(imageBuffer.data(), imageHeight);
+    else {
+      // gambar sudah utuh di memori, band langsung dibaca dari imageBuffer tanpa window
+      encode_rows(imageBuffer.data(), 0, 0, imageHeight);
+      ws.row = imageHeight;
     }
+    return end_write();
+  }
 
+  /* ==== API streaming ====
+   * Tulis: set_width/height/color_type/bit_depth, begin_write(), write_rows() berkali-kali
+   * dari atas ke bawah sampai get_height() baris, lalu end_write(). imageBuffer tidak
+   * dipakai, memori puncak cuma beberapa band (encoder paralel) atau satu baris (libpng).
+   * Hasilnya byte-identik dengan write() untuk mode encoder yang sama.
+   */
+  bool begin_write() {
+    release();
+    if (imageWidth <= 0 || imageHeight <= 0) return false;
+    if (output.is_open()) output.close();
     output.open(fileName, std::ios::binary | std::ios::out | std::ios::trunc);
     if (!output) return false;
-    int rowBytes = imageWidth * get_channel_count();
-    if (imageBuffer.size() != static_cast<size_t>(imageHeight * rowBytes)) imageBuffer.resize(imageHeight * rowBytes);
 
-    pngPtr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    ws          = {};
+    ws.rowBytes = get_row_bytes();
+    ws.bpp      = std::max<size_t>(1, get_channel_count() * imageBitDepth / 8);
+    if (encodeThreads != 1) {
+      begin_parallel();
+      return ws.ok = bool(output);
+    }
+
+    pngPtr     = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    pngReading = false;
     if (!pngPtr) return false;
     infoPtr = png_create_info_struct(pngPtr);
     if (!infoPtr || setjmp(png_jmpbuf(pngPtr))) return false;
 
     png_set_write_fn(pngPtr, static_cast<void *>(&output), png_write_callback, nullptr);
+    png_set_compression_level(pngPtr, compressionLevel);
     png_set_IHDR(pngPtr, infoPtr, imageWidth, imageHeight, imageBitDepth, imageColorType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
                  PNG_FILTER_TYPE_DEFAULT);
     png_write_info(pngPtr, infoPtr);
+    return ws.ok = true;
+  }
 
-    std::vector<png_bytep> rows(imageHeight);
-    for (int y = 0; y < imageHeight; y++) rows[y] = &imageBuffer[y * rowBytes];
+  // count baris berurutan, stride get_row_bytes(), @return false kalau error atau melebihi tinggi gambar
+  bool write_rows(const png_byte *rows, size_t count) {
+    if (!ws.ok || ws.row + count > size_t(imageHeight)) return ws.ok = false;
+    const size_t n = ws.rowBytes;
+    if (encodeThreads == 1) return write_rows_libpng(rows, count);
+    while (count) {
+      // window diisi sampai chunkRows baris baru supaya semua thread kebagian band
+      const size_t take = std::min(count, ws.chunkRows - (ws.row - ws.encodedRow));
+      ws.window.insert(ws.window.end(), rows, rows + take * n);
+      ws.row += take;
+      rows   += take * n;
+      count  -= take;
+      if (ws.row - ws.encodedRow == ws.chunkRows || ws.row == size_t(imageHeight)) flush_window();
+    }
+    return ws.ok;
+  }
+
+  bool end_write() {
+    bool ok = ws.ok && ws.row == size_t(imageHeight);
+    if (encodeThreads == 1 && pngPtr) {
+      if (setjmp(png_jmpbuf(pngPtr))) return ws.ok = false;
+      if (ok) png_write_end(pngPtr, nullptr);
+    } else if (ok) write_chunk("IEND", nullptr, 0);
+    output.flush();
+    ws.window = {};
+    ws.ok     = false;
+    return ok && bool(output);
+  }
+
+  /* producer(y, n, dst) mengisi baris [y, y + n) ke dst (stride get_row_bytes()),
+   * dipanggil berurutan dari atas. rowsPerCall = 0 pakai ukuran chunk encoder.
+   */
+  template <typename Producer>
+  bool write_stream(Producer &&producer, size_t rowsPerCall = 0) {
+    if (!begin_write()) return false;
+    const size_t height = size_t(imageHeight), n = rowsPerCall ? rowsPerCall : encodeThreads == 1 ? 16 : ws.chunkRows;
+    std::vector<png_byte> band(std::min(n, height) * ws.rowBytes);
+    for (size_t y = 0; y < height; y += n) {
+      const size_t k = std::min(n, height - y);
+      producer(y, k, band.data());
+      if (!write_rows(band.data(), k)) break;
+    }
+    return end_write();
+  }
+
+  /* Baca: begin_read() cuma membaca header (ukuran dan tipe langsung tersedia lewat
+   * getter), baris diambil satu per satu lewat next_row() atau range rows().
+   * Gambar interlaced ditolak karena barisnya tidak datang berurutan.
+   */
+  bool begin_read() {
+    release();
+    if (input.is_open()) input.close();
+    input.open(fileName, std::ios::binary);
+    if (!input) return false;
+
+    pngPtr     = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    pngReading = true;
+    if (!pngPtr) return false;
+    infoPtr = png_create_info_struct(pngPtr);
+    if (!infoPtr || setjmp(png_jmpbuf(pngPtr))) return false;
+
+    png_set_read_fn(pngPtr, static_cast<void *>(&input), png_read_callback);
+    png_read_info(pngPtr, infoPtr);
+    if (png_get_interlace_type(pngPtr, infoPtr) != PNG_INTERLACE_NONE) return false;
+
+    imageWidth     = png_get_image_width(pngPtr, infoPtr);
+    imageHeight    = png_get_image_height(pngPtr, infoPtr);
+    imageColorType = png_get_color_type(pngPtr, infoPtr);
+    imageBitDepth  = png_get_bit_depth(pngPtr, infoPtr);
+    png_read_update_info(pngPtr, infoPtr);
 
-    png_write_image(pngPtr, rows.data());
-    png_write_end(pngPtr, nullptr);
+    readRow.resize(png_get_rowbytes(pngPtr, infoPtr));
+    readRowIndex = 0;
     return true;
   }
 
+  // @return baris berikutnya (valid sampai panggilan berikutnya), nullptr kalau habis atau error
+  const png_byte *next_row() {
+    if (!pngPtr || !pngReading || readRowIndex >= size_t(imageHeight)) return nullptr;
+    if (setjmp(png_jmpbuf(pngPtr))) return nullptr;
+    png_read_row(pngPtr, readRow.data(), nullptr);
+    ++readRowIndex;
+    return readRow.data();
+  }
+
+  class RowIterator {
+    PNG            *png;
+    const png_byte *row;
+
+   public:
+    using value_type      = const png_byte *;
+    using difference_type = std::ptrdiff_t;
+
+    explicit RowIterator(PNG *png) : png(png), row(png->next_row()) {}
+    const png_byte *operator*() const { return row; }
+    RowIterator    &operator++() {
+      row = png->next_row();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const { return !row; }
+  };
+
+  struct RowRange {
+    PNG                    *png;
+    RowIterator             begin() const { return RowIterator(png); }
+    std::default_sentinel_t end() const { return {}; }
+  };
+
+  // for (const png_byte *row : png.rows()) ..., panggil begin_read() dulu
+  RowRange rows() { return {this}; }
+
   png_byte &pixel(int x, int y, int channel = 0) { return imageBuffer[(y * imageWidth + x) * get_channel_count() + channel]; }
 
   // Getters
@@ -133,6 +474,7 @@ class PNG {
   int                          get_height() const { return imageHeight; }
   png_byte                     get_color_type() const { return imageColorType; }
   png_byte                     get_bit_depth() const { return imageBitDepth; }
+  size_t                       get_row_bytes() const { return (size_t(imageWidth) * get_channel_count() * imageBitDepth + 7) / 8; }
   const std::vector<png_byte> &get_buffer() const { return imageBuffer; }
 
   // Setters
@@ -140,7 +482,20 @@ class PNG {
   void set_height(int h) { imageHeight = h; }
   void set_color_type(png_byte ct) { imageColorType = ct; }
   void set_bit_depth(png_byte bd) { imageBitDepth = bd; }
-  void set_buffer(const std::vector<png_byte> &buf) { imageBuffer = buf; }
+  // diambil alih tanpa copy kalau dioper dengan std::move
+  void set_buffer(std::vector<png_byte> buf) { imageBuffer = std::move(buf); }
+  // kembalikan buffer ke pemanggil, PNG jadi kosong
+  std::vector<png_byte> take_buffer() {
+    std::vector<png_byte> buf = std::move(imageBuffer);
+    imageBuffer.clear();
+    return buf;
+  }
+  /* 1 (default) = libpng satu thread, 0 = encoder band paralel dengan semua core,
+   * n > 1 = encoder band paralel dengan n thread. Hasilnya tetap PNG standar.
+   */
+  void set_encode_threads(int n) { encodeThreads = n; }
+  // level zlib 0..9, dipakai dua jalur encoder
+  void set_compression_level(int level) { compressionLevel = level; }
   void set_filename(const std::string &fileName) {
     if (input.is_open()) input.close();
     if (output.is_open()) output.close();
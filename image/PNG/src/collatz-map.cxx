@@ -0,0 +1,114 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <discrete/include/collatz.hxx>
+#include <iostream>
+#include <png.hxx>
+#include <string>
+#include <vector>
+
+uint64_t WIDTH, HEIGHT, FIRST = 1;
+
+uint64_t to_number_with_suffix(const char *str) {
+  using namespace std;
+  size_t   len = strlen(str);
+  uint64_t num = 0;
+
+  for (uint64_t i = 0; i < len; ++i) {
+    char c = str[i];
+    if (c >= '0' && c <= '9') num = num * 10 + (c - '0');
+    else {
+      char suffix = tolower(str[i]);
+      switch (suffix) {
+        case 'k': return num << 10;
+        case 'm': return num << 20;
+        case 'g': return num << 30;
+        case 't': return num << 40;
+        case 'p': return num << 50;
+        case 'e': return num << 60;
+        default: std::cerr << "Invalid suffix: " << str[i] << endl; exit(1);
+      }
+    }
+  }
+  return num;
+}
+
+// gradien hitam → ungu → merah → oranye → kuning pucat, t di [0, 1]
+void heat(float t, png_byte *rgb) {
+  static constexpr float stops[5][3] = {{0, 0, 4}, {87, 16, 110}, {188, 55, 84}, {249, 142, 9}, {252, 255, 164}};
+  const float            x = std::clamp(t, 0.0f, 1.0f) * 4;
+  const int              i = std::min(int(x), 3);
+  const float            f = x - i;
+  for (int c = 0; c < 3; ++c) rgb[c] = png_byte(stops[i][c] + (stops[i + 1][c] - stops[i][c]) * f);
+}
+
+/* Heatmap total stopping time: piksel (x, y) = seed FIRST + y·WIDTH + x.
+ * Pass pertama cuma statistik (maksimum untuk skala warna), pass kedua menghitung
+ * ulang per band langsung ke PNG streaming, jadi memori tidak tergantung luas gambar.
+ */
+int main(int argc, const char *argv[]) {
+  using namespace Discrete;
+  using clock = std::chrono::steady_clock;
+  if (argc < 2 || argc > 4) {
+    std::cerr << argv[0] << " <WIDTH> [HEIGHT] [FIRST SEED]" << std::endl;
+    exit(1);
+  }
+  WIDTH  = to_number_with_suffix(argv[1]);
+  HEIGHT = argc >= 3 ? to_number_with_suffix(argv[2]) : WIDTH;
+  if (argc == 4) FIRST = to_number_with_suffix(argv[3]);
+  if (!WIDTH || !HEIGHT || !FIRST) {
+    std::cerr << "WIDTH, HEIGHT and FIRST SEED must be positive" << std::endl;
+    exit(1);
+  }
+  const std::string filename = "collatz-" + std::to_string(FIRST) + "-" + std::to_string(WIDTH) + "-" + std::to_string(HEIGHT) + ".png";
+
+  try {
+    Collatz    collatz;
+    auto       start = clock::now();
+    const auto stats = collatz.range(FIRST, WIDTH * HEIGHT);
+    std::cout << "max stopping time " << stats.maxSteps << " at " << stats.argMax << ", mean " << stats.meanSteps << " ("
+              << std::chrono::duration<double, std::milli>(clock::now() - start).count() << " ms)" << std::endl;
+
+    // skala akar supaya seed dengan lintasan pendek yang mayoritas tetap kelihatan bedanya
+    const float invMax = stats.maxSteps ? 1.0f / std::sqrt(float(stats.maxSteps)) : 0;
+
+    PNG writer(filename);
+    writer.set_width(WIDTH);
+    writer.set_height(HEIGHT);
+    writer.set_color_type(PNG_COLOR_TYPE_RGB);
+    writer.set_bit_depth(8);
+    writer.set_encode_threads(0);
+    std::vector<uint32_t> steps;
+    start = clock::now();
+    const bool ok = writer.write_stream([&](size_t y, size_t n, png_byte *dst) {
+      steps.resize(n * WIDTH);
+      collatz.stopping_times(FIRST + y * WIDTH, n * WIDTH, steps.data());
+      for (size_t i = 0; i < steps.size(); ++i) heat(std::sqrt(float(steps[i])) * invMax, dst + i * 3);
+    });
+    if (ok) std::cout << "berhasil ditulis ke " << filename << " (" << std::chrono::duration<double, std::milli>(clock::now() - start).count() << " ms)" << std::endl;
+    else std::cout << "gagal menulis ke " << filename << std::endl;
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
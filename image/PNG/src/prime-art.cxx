@@ -17,10 +17,15 @@
   along with this program. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <discrete/include/prime.hxx>
 #include <iostream>
+#include <numbers>
 #include <png.hxx>
 #include <string>
 #include <vector>
@@ -51,8 +56,53 @@ uint64_t to_number_with_suffix(const char *str) {
   return num;
 }
 
+/* Kanvas 1 bit per piksel, baris dipad ke kelipatan 64 bit. Untuk 64k × 64k cuma
+ * 512 MiB (RGB penuh 12 GiB), jadi dua spiral muat di memori sekaligus. Titik
+ * dari thread berbeda bisa jatuh di word yang sama, makanya set() pakai fetch_or.
+ * RGB baru dirakit per band waktu ditulis ke PNG streaming.
+ */
+struct Bitmap {
+  uint64_t              width, height, words;
+  std::vector<uint64_t> bits;
+
+  Bitmap(uint64_t w, uint64_t h) : width(w), height(h), words((w + 63) / 64), bits(words * h) {}
+
+  // bit = y · words · 64 + x
+  void set(uint64_t bit) { std::atomic_ref<uint64_t>(bits[bit >> 6]).fetch_or(1ULL << (bit & 63), std::memory_order_relaxed); }
+
+  // baris [y, y + n) ke dst RGB, piksel yang diset jadi biru
+  void to_rgb(size_t y, size_t n, png_byte *dst) const {
+    std::memset(dst, 0, n * width * 3);
+    for (size_t r = 0; r < n; ++r) {
+      const uint64_t *row = &bits[(y + r) * words];
+      png_byte       *out = dst + r * width * 3;
+      for (uint64_t w = 0; w < words; ++w)
+        for (uint64_t m = row[w]; m; m &= m - 1) out[((w << 6) + std::countr_zero(m)) * 3 + 2] = 255;
+    }
+  }
+};
+
+/* sin dan cos sekaligus tanpa cabang supaya loop omp simd jadi instruksi vektor:
+ * x = k·π/2 + r dengan |r| <= π/4 (Cody-Waite 3 bagian), deret Taylor sampai r^13/r^14
+ * (error ~1e-14), lalu tukar/negasi sesuai kuadran k mod 4. Untuk theta sampai ~1e9
+ * error reduksinya masih jauh di bawah satu piksel.
+ */
+inline void fast_sincos(double x, double &s, double &c) {
+  constexpr double invPio2 = 2 / std::numbers::pi, pio2_1 = 1.57079632673412561417e+00, pio2_2 = 6.07710050630396597660e-11,
+                   pio2_3 = 2.02226624879595063154e-21;
+  const double  k  = std::nearbyint(x * invPio2);
+  const double  r  = x - k * pio2_1 - k * pio2_2 - k * pio2_3;
+  const double  r2 = r * r;
+  const double  sp = r + r * r2 * (-1.0 / 6 + r2 * (1.0 / 120 + r2 * (-1.0 / 5040 + r2 * (1.0 / 362880 + r2 * (-1.0 / 39916800 + r2 * (1.0 / 6227020800))))));
+  const double  cp = 1 + r2 * (-0.5 + r2 * (1.0 / 24 + r2 * (-1.0 / 720 + r2 * (1.0 / 40320 + r2 * (-1.0 / 3628800 + r2 * (1.0 / 479001600 - r2 / 87178291200))))));
+  const int64_t q  = int64_t(k) & 3;
+  s                = q == 0 ? sp : q == 1 ? cp : q == 2 ? -sp : -cp;
+  c                = q == 0 ? cp : q == 1 ? -sp : q == 2 ? -cp : sp;
+}
+
 int main(int argc, const char *argv[]) {
   using namespace Discrete;
+  using clock = std::chrono::steady_clock;
   if (argc < 2 || argc > 3) {
     std::cerr << argv[0] << " <WIDTH> <HEIGHT>" << std::endl;
     exit(1);
@@ -63,15 +113,9 @@ int main(int argc, const char *argv[]) {
   AREA                  = WIDTH * HEIGHT;
   std::string filename  = "prime-uniform-" + std::to_string(WIDTH) + "-" + std::to_string(HEIGHT) + ".png";
   std::string filename2 = "prime-spiral-" + std::to_string(WIDTH) + "-" + std::to_string(HEIGHT) + ".png";
-  PNG         writer(filename);
-  writer.set_width(WIDTH);
-  writer.set_height(HEIGHT);
-  writer.set_color_type(PNG_COLOR_TYPE_RGB);
-  writer.set_bit_depth(8);
-
-  std::vector<png_byte> data(AREA * 3), data2(AREA * 3);
 
-  auto &prime = Prime<uint64_t>::instance();
+  auto  &prime = Prime<uint64_t>::instance();
+  Bitmap uniform(WIDTH, HEIGHT), spiral(WIDTH, HEIGHT);
 
   /* Solve r untuk setiap i
    *
@@ -89,52 +133,58 @@ int main(int argc, const char *argv[]) {
    * maka dTheta = 1/r
    * karena r = dR * sqrt(i) dan dR = sqrt(2)/2 maka
    * dTheta = 2/sqrt(2) * sqrt(i)
+   * jadi theta = dTheta * i = sqrt(2i)
    */
 
-  float          dR = 0.5 * std::sqrt(2.0f);
-  const uint64_t cx = WIDTH / 2;
-  const uint64_t cy = HEIGHT / 2;
-
-  for (uint32_t i : prime.from_range_limit(AREA)) {
-    const float   dTheta = 2 / std::sqrt(2 * i);
-    const float   r      = dR * std::sqrt(i);
-    const float   theta  = dTheta * i;
-    const int64_t dx     = r * std::cos(theta);
-    const int64_t dy     = r * std::sin(theta);
-    if (std::abs(dx) > WIDTH / 2 || std::abs(dy) > HEIGHT / 2) continue;
-    uint64_t x     = uint64_t(cx + dx);
-    uint64_t y     = uint64_t(cy + dy);
-    uint64_t n     = y * WIDTH + x;
-    uint64_t base  = (n) * 3;
-    data[base + 0] = 0;
-    data[base + 1] = 0;
-    data[base + 2] = 255;
-  }
-
-  writer.set_buffer(data);
-  if (writer.write()) std::cout << "berhasil ditulis ke " << filename << std::endl;
-  else std::cout << "gagal menulis ke " << filename << std::endl;
-
   // spiral logarithmic cek ini
   // https://en.wikipedia.org/wiki/Logarithmic_spiral
-  const float dTheta = std::log(dR);
-  for (uint32_t i : prime.from_range_limit(AREA)) {
-    float         r     = dR * std::sqrt(i);
-    float         theta = dTheta * i;
-    const int64_t dx    = r * std::cos(theta);
-    const int64_t dy    = r * std::sin(theta);
-    if (std::abs(dx) > WIDTH / 2 || std::abs(dy) > HEIGHT / 2) continue;
-    uint64_t x      = uint64_t(cx + dx);
-    uint64_t y      = uint64_t(cy + dy);
-    uint64_t n      = y * WIDTH + x;
-    uint64_t base   = (n) * 3;
-    data2[base + 0] = 0;
-    data2[base + 1] = 0;
-    data2[base + 2] = 255;
+  const double   dR        = 0.5 * std::sqrt(2.0);
+  const double   dThetaLog = std::log(dR);
+  const int64_t  cx = WIDTH / 2, cy = HEIGHT / 2;
+  const uint64_t NONE      = ~uint64_t(0), rowBits = uniform.words * 64;
+
+  // posisi piksel dihitung vektor per segmen ke buffer per thread, baru di-scatter ke kanvas
+  std::vector<std::vector<uint64_t>> scratch(Prime<uint64_t>::max_thread());
+  auto                               place = [&](double r, double theta) {
+    double s, c;
+    fast_sincos(theta, s, c);
+    const int64_t dx = int64_t(r * c), dy = int64_t(r * s);
+    const int64_t x = cx + dx, y = cy + dy;
+    return std::abs(dx) > cx || std::abs(dy) > cy || x >= int64_t(WIDTH) || y >= int64_t(HEIGHT) ? NONE : uint64_t(y) * rowBits + uint64_t(x);
+  };
+
+  // satu pass: prima dialirkan per segmen dan dua spiral digambar sekaligus
+  const auto start = clock::now();
+  prime.for_each_segment(AREA, [&](int tid, const uint64_t *p, size_t n) {
+    std::vector<uint64_t> &pos = scratch[tid];
+    pos.resize(2 * n);
+    uint64_t *pu = pos.data(), *ps = pos.data() + n;
+#pragma omp simd
+    for (size_t k = 0; k < n; ++k) {
+      const double i = double(p[k]), r = dR * std::sqrt(i);
+      pu[k]          = place(r, std::sqrt(2 * i));
+      ps[k]          = place(r, dThetaLog * i);
+    }
+    for (size_t k = 0; k < n; ++k) {
+      if (pu[k] != NONE) uniform.set(pu[k]);
+      if (ps[k] != NONE) spiral.set(ps[k]);
+    }
+  });
+  const double renderMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  std::cout << "render " << renderMs << " ms" << std::endl;
+
+  // ditulis streaming per band dari kanvas bit, buffer RGB cuma sebesar satu band
+  for (auto [bitmap, name] : {std::pair{&uniform, &filename}, std::pair{&spiral, &filename2}}) {
+    PNG writer(*name);
+    writer.set_width(WIDTH);
+    writer.set_height(HEIGHT);
+    writer.set_color_type(PNG_COLOR_TYPE_RGB);
+    writer.set_bit_depth(8);
+    // gambar puluhan ribu piksel: deflate dipecah per band ke semua core
+    writer.set_encode_threads(0);
+    const auto t0 = clock::now();
+    if (writer.write_stream([&](size_t y, size_t n, png_byte *dst) { bitmap->to_rgb(y, n, dst); }))
+      std::cout << "berhasil ditulis ke " << *name << " (" << std::chrono::duration<double, std::milli>(clock::now() - t0).count() << " ms)" << std::endl;
+    else std::cout << "gagal menulis ke " << *name << std::endl;
   }
-
-  writer.set_filename(filename2);
-  writer.set_buffer(data2);
-  if (writer.write()) std::cout << "berhasil ditulis ke " << filename2 << std::endl;
-  else std::cout << "gagal menulis ke " << filename2 << std::endl;
 }
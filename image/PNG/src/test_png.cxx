@@ -0,0 +1,117 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <png.hxx>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Untuk tiap mode encoder (libpng, 0 = semua core, 3 thread): write(), write_stream()
+ * dan begin_write() + write_rows() dengan potongan tidak beraturan harus menghasilkan
+ * file yang byte-identik, lalu begin_read() + rows() harus mengembalikan piksel asal.
+ */
+namespace {
+constexpr int W = 301, H = 517;
+
+// gradien halus + blok noise supaya semua jenis filter baris terpakai
+std::vector<png_byte> make_image(size_t channels) {
+  std::mt19937                       gen(7);
+  std::uniform_int_distribution<int> dis(0, 255);
+  std::vector<png_byte>              img(size_t(W) * H * channels);
+  for (int y = 0; y < H; ++y)
+    for (int x = 0; x < W; ++x)
+      for (size_t c = 0; c < channels; ++c) {
+        const bool noisy                        = ((x / 37) + (y / 29)) % 3 == 0;
+        img[(size_t(y) * W + x) * channels + c] = png_byte(noisy ? dis(gen) : (x * (c + 1) + y * 3) & 0xff);
+      }
+  return img;
+}
+
+std::vector<char> slurp(const std::string &path) {
+  std::ifstream ifs(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+}
+
+void setup(PNG &png, png_byte colorType, int threads) {
+  png.set_width(W);
+  png.set_height(H);
+  png.set_color_type(colorType);
+  png.set_bit_depth(8);
+  png.set_encode_threads(threads);
+}
+
+bool check(png_byte colorType, size_t channels, int threads, const std::string &dir) {
+  const auto        img      = make_image(channels);
+  const size_t      rowBytes = size_t(W) * channels;
+  const std::string base     = dir + "/test_png_" + std::to_string(channels) + "_" + std::to_string(threads);
+  const std::string pWrite = base + "_write.png", pStream = base + "_stream.png", pRows = base + "_rows.png";
+
+  PNG a(pWrite);
+  setup(a, colorType, threads);
+  a.set_buffer(img);
+  bool ok = a.write();
+
+  PNG b(pStream);
+  setup(b, colorType, threads);
+  ok &= b.write_stream([&](size_t y, size_t n, png_byte *dst) { std::memcpy(dst, img.data() + y * rowBytes, n * rowBytes); }, 7);
+
+  PNG c(pRows);
+  setup(c, colorType, threads);
+  ok &= c.begin_write();
+  const size_t chunks[] = {1, 5, 13, 2, 64, 3};
+  for (size_t y = 0, i = 0; y < size_t(H); ++i) {
+    const size_t n = std::min(chunks[i % std::size(chunks)], size_t(H) - y);
+    ok &= c.write_rows(img.data() + y * rowBytes, n);
+    y  += n;
+  }
+  ok &= c.end_write();
+
+  const auto fWrite = slurp(pWrite);
+  const bool same   = !fWrite.empty() && fWrite == slurp(pStream) && fWrite == slurp(pRows);
+
+  PNG  r(pRows);
+  bool roundTrip = r.begin_read() && r.get_width() == W && r.get_height() == H && r.get_row_bytes() == rowBytes;
+  int  y         = 0;
+  for (const png_byte *row : r.rows()) {
+    if (y >= H || std::memcmp(row, img.data() + size_t(y) * rowBytes, rowBytes)) roundTrip = false;
+    ++y;
+  }
+  roundTrip &= y == H;
+
+  for (const auto &p : {pWrite, pStream, pRows}) std::filesystem::remove(p);
+  std::cout << channels << " channel, encode threads " << threads << ": write " << std::boolalpha << ok << ", byte-identical " << same
+            << ", round trip " << roundTrip << std::endl;
+  return ok && same && roundTrip;
+}
+}  // namespace
+
+int main() {
+  const std::string dir = std::filesystem::temp_directory_path().string();
+  bool              ok  = true;
+  for (int threads : {1, 0, 3}) {
+    ok &= check(PNG_COLOR_TYPE_RGB, 3, threads, dir);
+    ok &= check(PNG_COLOR_TYPE_RGBA, 4, threads, dir);
+  }
+  return ok ? 0 : 1;
+}
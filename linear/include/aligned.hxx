@@ -0,0 +1,66 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace Linear {
+
+// 64 byte = satu cache line, sekaligus cukup untuk load AVX-512 tanpa split
+inline constexpr std::size_t CACHE_LINE = 64;
+
+/* Allocator untuk std::vector supaya awal buffer selalu rata ke Align byte.
+ * Pakai aligned operator new bawaan C++17 jadi tidak perlu posix_memalign/_aligned_malloc.
+ */
+template <typename T, std::size_t Align = CACHE_LINE>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Align>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Align> &) noexcept {}
+
+  T *allocate(std::size_t n) { return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Align))); }
+  void deallocate(T *p, std::size_t) noexcept { ::operator delete(p, std::align_val_t(Align)); }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Align> &) const noexcept {
+    return true;
+  }
+};
+
+template <typename T>
+using aligned_vector = std::vector<T, AlignedAllocator<T>>;
+
+// bulatkan n ke atas ke kelipatan satu cache line (dalam jumlah elemen)
+template <typename T>
+constexpr std::size_t pad_to_cache_line(std::size_t n) {
+  constexpr std::size_t per_line = CACHE_LINE / sizeof(T) ? CACHE_LINE / sizeof(T) : 1;
+  return (n + per_line - 1) / per_line * per_line;
+}
+
+}  // namespace Linear
@@ -0,0 +1,103 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+/* Fungsi <cmath> yang bisa dipanggil saat compile time.
+ * Di runtime langsung diteruskan ke std:: (lebih cepat dan presisi penuh),
+ * versi iteratif di bawah cuma dipakai saat constant evaluation supaya
+ * matriks proyeksi/kamera yang parameternya konstan bisa dilipat compiler.
+ */
+
+namespace Linear::cx {
+
+template <std::floating_point T>
+constexpr T abs(T x) {
+  return x < 0 ? -x : x;
+}
+
+template <std::floating_point T>
+constexpr T sqrt(T x) {
+  if (!std::is_constant_evaluated()) return std::sqrt(x);
+  if (x <= 0) return x == 0 ? x : std::numeric_limits<T>::quiet_NaN();
+  // newton, tebakan awal cukup kasar karena konvergensinya kuadratik
+  double r = x > 1 ? double(x) : 1.0;
+  for (int i = 0; i < 128; ++i) {
+    double next = 0.5 * (r + double(x) / r);
+    if (next == r) break;
+    r = next;
+  }
+  return static_cast<T>(r);
+}
+
+namespace detail {
+// reduksi ke [-pi, pi] lalu deret taylor, cukup sampai suku kecil dari epsilon double
+constexpr double reduce(double x) {
+  constexpr double two_pi = 2 * std::numbers::pi;
+  x                       = x - two_pi * static_cast<double>(static_cast<long long>(x / two_pi));
+  if (x > std::numbers::pi) x -= two_pi;
+  if (x < -std::numbers::pi) x += two_pi;
+  return x;
+}
+
+constexpr double sin_series(double x) {
+  double term = x, sum = x;
+  for (int k = 1; k < 30; ++k) {
+    term *= -x * x / ((2 * k) * (2 * k + 1));
+    sum  += term;
+  }
+  return sum;
+}
+
+constexpr double cos_series(double x) {
+  double term = 1, sum = 1;
+  for (int k = 1; k < 30; ++k) {
+    term *= -x * x / ((2 * k - 1) * (2 * k));
+    sum  += term;
+  }
+  return sum;
+}
+}  // namespace detail
+
+template <std::floating_point T>
+constexpr T sin(T x) {
+  if (!std::is_constant_evaluated()) return std::sin(x);
+  return static_cast<T>(detail::sin_series(detail::reduce(x)));
+}
+
+template <std::floating_point T>
+constexpr T cos(T x) {
+  if (!std::is_constant_evaluated()) return std::cos(x);
+  return static_cast<T>(detail::cos_series(detail::reduce(x)));
+}
+
+template <std::floating_point T>
+constexpr T tan(T x) {
+  if (!std::is_constant_evaluated()) return std::tan(x);
+  const double r = detail::reduce(x);
+  return static_cast<T>(detail::sin_series(r) / detail::cos_series(r));
+}
+
+}  // namespace Linear::cx
@@ -0,0 +1,157 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "aligned.hxx"
+
+namespace Linear {
+
+enum MATRIX_LAYOUT { ROW_MAJOR, COL_MAJOR };
+
+/* View non-owning ke blok matriks mana saja, elemen (i, j) ada di
+ * ptr[i * rowStride + j * colStride]. Row-major berarti colStride = 1,
+ * col-major berarti rowStride = 1, transpose cukup tukar stride tanpa copy.
+ * T boleh const untuk view read-only.
+ */
+template <typename T>
+class MatrixView {
+  T          *ptr = nullptr;
+  std::size_t nRows = 0, nCols = 0, rowStride = 0, colStride = 0;
+
+ public:
+  MatrixView() = default;
+  MatrixView(T *ptr, std::size_t rows, std::size_t cols, std::size_t rowStride, std::size_t colStride)
+      : ptr(ptr), nRows(rows), nCols(cols), rowStride(rowStride), colStride(colStride) {}
+
+  // view dengan leading dimension ld, ld default = lebar baris (atau tinggi kolom untuk col-major)
+  static MatrixView from_layout(T *ptr, std::size_t rows, std::size_t cols, MATRIX_LAYOUT layout, std::size_t ld = 0) {
+    if (layout == ROW_MAJOR) return MatrixView(ptr, rows, cols, ld ? ld : cols, 1);
+    return MatrixView(ptr, rows, cols, 1, ld ? ld : rows);
+  }
+
+  // view non-const bisa otomatis jadi view const
+  operator MatrixView<const T>() const requires(!std::is_const_v<T>) { return MatrixView<const T>(ptr, nRows, nCols, rowStride, colStride); }
+
+  T &operator()(std::size_t i, std::size_t j) const {
+    assert(i < nRows && j < nCols);
+    return ptr[i * rowStride + j * colStride];
+  }
+
+  std::size_t rows() const { return nRows; }
+  std::size_t cols() const { return nCols; }
+  std::size_t row_stride() const { return rowStride; }
+  std::size_t col_stride() const { return colStride; }
+  T          *data() const { return ptr; }
+
+  bool is_row_major() const { return colStride == 1; }
+  bool is_col_major() const { return rowStride == 1; }
+
+  MatrixView transposed() const { return MatrixView(ptr, nCols, nRows, colStride, rowStride); }
+
+  // sub-blok [r0, r0 + rows) × [c0, c0 + cols)
+  MatrixView block(std::size_t r0, std::size_t c0, std::size_t rows, std::size_t cols) const {
+    assert(r0 + rows <= nRows && c0 + cols <= nCols);
+    return MatrixView(ptr + r0 * rowStride + c0 * colStride, rows, cols, rowStride, colStride);
+  }
+
+  // satu baris sebagai span, hanya valid untuk row-major
+  std::span<T> row(std::size_t i) const {
+    assert(is_row_major() && i < nRows);
+    return std::span<T>(ptr + i * rowStride, nCols);
+  }
+};
+
+/* Matriks ukuran dinamis rows × cols, storage satu blok heap yang rata 64 byte,
+ * disimpan row-major. Buat matriks kecil ukuran tetap (transformasi 3D) tetap
+ * pakai Mat<T, N> di matrix.hxx, kelas ini untuk ukuran besar seperti bobot NN.
+ */
+template <std::floating_point T>
+class Matrix {
+  std::size_t       nRows = 0, nCols = 0;
+  aligned_vector<T> vals;
+
+ public:
+  using value_type = T;
+
+  Matrix() = default;
+  Matrix(std::size_t rows, std::size_t cols, T init = 0) : nRows(rows), nCols(cols), vals(rows * cols, init) {}
+  Matrix(std::size_t rows, std::size_t cols, std::initializer_list<T> v) : nRows(rows), nCols(cols), vals(v) {
+    if (v.size() != rows * cols) throw std::invalid_argument("Matrix: initializer size doesn't match rows * cols");
+  }
+
+  // salin isi view apa saja (termasuk view col-major / transpose) jadi Matrix baru
+  explicit Matrix(MatrixView<const T> v) : Matrix(v.rows(), v.cols()) {
+    for (std::size_t i = 0; i < nRows; ++i)
+      for (std::size_t j = 0; j < nCols; ++j) vals[i * nCols + j] = v(i, j);
+  }
+
+  static Matrix identity(std::size_t n) {
+    Matrix res(n, n);
+    for (std::size_t i = 0; i < n; ++i) res(i, i) = 1;
+    return res;
+  }
+
+  // data lama tidak dipertahankan posisinya, kapasitas dipakai ulang kalau cukup
+  void resize(std::size_t rows, std::size_t cols, T init = 0) {
+    nRows = rows;
+    nCols = cols;
+    vals.assign(rows * cols, init);
+  }
+
+  void fill(T v) { std::fill(vals.begin(), vals.end(), v); }
+
+  T &operator()(std::size_t i, std::size_t j) {
+    assert(i < nRows && j < nCols);
+    return vals[i * nCols + j];
+  }
+  const T &operator()(std::size_t i, std::size_t j) const {
+    assert(i < nRows && j < nCols);
+    return vals[i * nCols + j];
+  }
+
+  std::size_t rows() const { return nRows; }
+  std::size_t cols() const { return nCols; }
+  std::size_t size() const { return vals.size(); }
+  T          *data() { return vals.data(); }
+  const T    *data() const { return vals.data(); }
+
+  std::span<T>       row(std::size_t i) { return std::span<T>(vals.data() + i * nCols, nCols); }
+  std::span<const T> row(std::size_t i) const { return std::span<const T>(vals.data() + i * nCols, nCols); }
+
+  MatrixView<T>       view() { return MatrixView<T>(vals.data(), nRows, nCols, nCols, 1); }
+  MatrixView<const T> view() const { return MatrixView<const T>(vals.data(), nRows, nCols, nCols, 1); }
+  // transpose tanpa copy, hasilnya view col-major ke storage yang sama
+  MatrixView<T>       transposed() { return view().transposed(); }
+  MatrixView<const T> transposed() const { return view().transposed(); }
+
+  operator MatrixView<T>() { return view(); }
+  operator MatrixView<const T>() const { return view(); }
+};
+
+}  // namespace Linear
@@ -0,0 +1,144 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/* Expression template untuk Vec dan Mat.
+ * Operasi element-wise (+, -, *, / dan skalar) tidak langsung dihitung, tapi
+ * dibungkus jadi node kecil yang cuma nyimpen operand. Nilainya baru dihitung
+ * satu loop sekali jalan ketika di-assign ke Vec/Mat, jadi chain seperti
+ * a + b * s - c tidak bikin objek sementara sama sekali.
+ *
+ * Setiap node wajib punya:
+ *   value_type          tipe elemen hasil
+ *   size                jumlah elemen linear (N untuk Vec, N*N untuk Mat)
+ *   dim                 N
+ *   is_leaf             true hanya untuk Vec/Mat asli
+ *   coeff(i)            elemen ke-i (row-major untuk Mat)
+ *   reads_across(p)     true kalau coeff(i) membaca elemen lain dari objek p
+ *                       (cuma terjadi di perkalian matriks), dipakai buat cek aliasing
+ */
+
+namespace Linear {
+
+struct VecExprTag {};
+struct MatExprTag {};
+
+template <typename E>
+using expr_t = std::remove_cvref_t<E>;
+
+template <typename E>
+concept vec_expr = std::derived_from<expr_t<E>, VecExprTag>;
+template <typename E>
+concept mat_expr = std::derived_from<expr_t<E>, MatExprTag>;
+template <typename S>
+concept scalar = std::integral<expr_t<S>> || std::floating_point<expr_t<S>>;
+template <typename E>
+concept float_vec_expr = vec_expr<E> && std::floating_point<typename expr_t<E>::value_type>;
+template <typename A, typename B>
+concept same_size = expr_t<A>::size == expr_t<B>::size;
+
+/* Vec/Mat lvalue cukup disimpan referensinya, sisanya (node lain atau leaf
+ * rvalue) disimpan by value supaya tidak dangling kalau ekspresinya disimpan
+ * pakai auto.
+ */
+template <typename E>
+using expr_store_t = std::conditional_t<std::is_lvalue_reference_v<E> && expr_t<E>::is_leaf, const expr_t<E> &, expr_t<E>>;
+
+// node element-wise dua operand, Tag menentukan hasilnya Vec atau Mat
+template <typename Tag, typename L, typename R, typename Op>
+class ElemExpr : public Tag {
+  expr_store_t<L> l;
+  expr_store_t<R> r;
+
+ public:
+  using value_type              = typename expr_t<L>::value_type;
+  static constexpr int  size    = expr_t<L>::size;
+  static constexpr int  dim     = expr_t<L>::dim;
+  static constexpr bool is_leaf = false;
+
+  template <typename A, typename B>
+  constexpr ElemExpr(A &&a, B &&b) : l(std::forward<A>(a)), r(std::forward<B>(b)) {}
+
+  constexpr value_type coeff(int i) const { return Op{}(l.coeff(i), static_cast<value_type>(r.coeff(i))); }
+  constexpr bool       reads_across(const void *p) const { return l.reads_across(p) || r.reads_across(p); }
+};
+
+// node operasi dengan skalar, skalar selalu di sisi kanan (s * e juga diarahkan ke sini)
+template <typename Tag, typename E, typename Op>
+class ScalarExpr : public Tag {
+ public:
+  using value_type = typename expr_t<E>::value_type;
+
+ private:
+  expr_store_t<E> e;
+  value_type      s;
+
+ public:
+  static constexpr int  size    = expr_t<E>::size;
+  static constexpr int  dim     = expr_t<E>::dim;
+  static constexpr bool is_leaf = false;
+
+  template <typename A>
+  constexpr ScalarExpr(A &&a, value_type s) : e(std::forward<A>(a)), s(s) {}
+
+  constexpr value_type coeff(int i) const { return Op{}(e.coeff(i), s); }
+  constexpr bool       reads_across(const void *p) const { return e.reads_across(p); }
+};
+
+// operator element-wise, macro biar tidak nulis ulang empat kali untuk Vec dan Mat
+#define EXPR_ELEM_OPERATOR(concept_name, Tag, op, Op)                                                        \
+  template <typename L, typename R>                                                                          \
+  requires(concept_name<L> && concept_name<R> && same_size<L, R>) constexpr auto operator op(L &&l, R &&r) { \
+    return ElemExpr<Tag, L, R, Op>(std::forward<L>(l), std::forward<R>(r));                                  \
+  }
+
+#define EXPR_SCALAR_OPERATOR(concept_name, Tag, op, Op)                                                \
+  template <typename E, typename S>                                                                    \
+  requires(concept_name<E> && scalar<S>) constexpr auto operator op(E &&e, S s) {                      \
+    return ScalarExpr<Tag, E, Op>(std::forward<E>(e), static_cast<typename expr_t<E>::value_type>(s)); \
+  }
+
+EXPR_ELEM_OPERATOR(vec_expr, VecExprTag, +, std::plus<>)
+EXPR_ELEM_OPERATOR(vec_expr, VecExprTag, -, std::minus<>)
+EXPR_ELEM_OPERATOR(vec_expr, VecExprTag, *, std::multiplies<>)
+EXPR_ELEM_OPERATOR(vec_expr, VecExprTag, /, std::divides<>)
+EXPR_SCALAR_OPERATOR(vec_expr, VecExprTag, *, std::multiplies<>)
+EXPR_SCALAR_OPERATOR(vec_expr, VecExprTag, /, std::divides<>)
+
+// untuk Mat cuma + dan - yang element-wise, * antar matriks ada di matrix.hxx
+EXPR_ELEM_OPERATOR(mat_expr, MatExprTag, +, std::plus<>)
+EXPR_ELEM_OPERATOR(mat_expr, MatExprTag, -, std::minus<>)
+EXPR_SCALAR_OPERATOR(mat_expr, MatExprTag, *, std::multiplies<>)
+EXPR_SCALAR_OPERATOR(mat_expr, MatExprTag, /, std::divides<>)
+#undef EXPR_ELEM_OPERATOR
+#undef EXPR_SCALAR_OPERATOR
+
+// agar komutatif
+template <typename S, typename E>
+requires(scalar<S> && (vec_expr<E> || mat_expr<E>)) constexpr auto operator*(S s, E &&e) {
+  return std::forward<E>(e) * s;
+}
+
+}  // namespace Linear
@@ -0,0 +1,292 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dense_matrix.hxx"
+#include "gemm.hxx"
+
+/* Faktorisasi LU (partial pivoting) dan Cholesky yang bisa dipakai ulang.
+ * Faktorisasi O(n³) dikerjakan sekali di konstruktor, setelah itu tiap
+ * solve cuma substitusi maju/mundur O(n²) per right-hand side.
+ *
+ * Keduanya right-looking blocked dengan lebar blok NB:
+ *   1. faktorkan panel NB kolom (unblocked, kecil jadi muat di cache)
+ *   2. selesaikan blok baris/kolom di sebelahnya dengan substitusi segitiga
+ *   3. update trailing matrix lewat gemm, di sinilah hampir semua flop dan
+ *      parallelisme OpenMP-nya
+ */
+
+namespace Linear {
+
+namespace factor_impl {
+
+inline constexpr std::size_t NB = 64;
+// kolom right-hand side per thread saat substitusi
+inline constexpr std::size_t RHS_CHUNK = 256;
+
+/* B = L⁻¹ B, L lower (UnitDiag = diagonal dianggap 1, untuk LU).
+ * Diupdate per baris B supaya loop dalamnya jalan di sepanjang baris (unit
+ * stride untuk B row-major), kolom B dibagi per chunk ke thread.
+ */
+template <typename T, bool UnitDiag>
+void forward_subst(MatrixView<const T> L, MatrixView<T> B) {
+  const std::size_t n = L.rows(), nrhs = B.cols(), chunks = (nrhs + RHS_CHUNK - 1) / RHS_CHUNK;
+#pragma omp parallel for schedule(static) if (chunks > 1)
+  for (std::size_t ch = 0; ch < chunks; ++ch) {
+    const std::size_t c0 = ch * RHS_CHUNK, c1 = std::min(nrhs, c0 + RHS_CHUNK);
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t r = 0; r < i; ++r) {
+        const T l = L(i, r);
+        for (std::size_t c = c0; c < c1; ++c) B(i, c) -= l * B(r, c);
+      }
+      if constexpr (!UnitDiag) {
+        const T inv = T(1) / L(i, i);
+        for (std::size_t c = c0; c < c1; ++c) B(i, c) *= inv;
+      }
+    }
+  }
+}
+
+// B = U⁻¹ B, U upper dengan diagonal asli. U yang dioper boleh view transpose (Lᵀ untuk Cholesky)
+template <typename T>
+void backward_subst(MatrixView<const T> U, MatrixView<T> B) {
+  const std::size_t n = U.rows(), nrhs = B.cols(), chunks = (nrhs + RHS_CHUNK - 1) / RHS_CHUNK;
+#pragma omp parallel for schedule(static) if (chunks > 1)
+  for (std::size_t ch = 0; ch < chunks; ++ch) {
+    const std::size_t c0 = ch * RHS_CHUNK, c1 = std::min(nrhs, c0 + RHS_CHUNK);
+    for (std::size_t i = n; i-- > 0;) {
+      for (std::size_t r = i + 1; r < n; ++r) {
+        const T u = U(i, r);
+        for (std::size_t c = c0; c < c1; ++c) B(i, c) -= u * B(r, c);
+      }
+      const T inv = T(1) / U(i, i);
+      for (std::size_t c = c0; c < c1; ++c) B(i, c) *= inv;
+    }
+  }
+}
+
+}  // namespace factor_impl
+
+/* PA = LU, L unit lower dan U upper disimpan bareng di satu Matrix.
+ * Pivot disimpan gaya LAPACK: di langkah j baris j ditukar dengan baris piv[j].
+ * Matriks singular (pivot persis 0) melempar std::runtime_error.
+ */
+template <std::floating_point T>
+class LU {
+  Matrix<T>                lu;
+  std::vector<std::size_t> piv;
+  int                      sign = 1;
+
+  // faktorkan kolom [k, k + kb) untuk baris [k, n), baris ditukar penuh supaya bagian kiri (L) ikut
+  void factor_panel(std::size_t k, std::size_t kb) {
+    const std::size_t n = lu.rows();
+    for (std::size_t j = k; j < k + kb; ++j) {
+      std::size_t p = j;
+      for (std::size_t i = j + 1; i < n; ++i)
+        if (std::abs(lu(i, j)) > std::abs(lu(p, j))) p = i;
+      if (lu(p, j) == T(0)) throw std::runtime_error("LU: singular matrix");
+      piv[j] = p;
+      if (p != j) {
+        std::swap_ranges(lu.row(j).begin(), lu.row(j).end(), lu.row(p).begin());
+        sign = -sign;
+      }
+
+      const T inv = T(1) / lu(j, j);
+      for (std::size_t i = j + 1; i < n; ++i) {
+        const T l = lu(i, j) *= inv;
+        // rank-1 update cuma di dalam panel, sisanya nanti lewat gemm
+        T       *dst = &lu(i, 0), *src = &lu(j, 0);
+#pragma omp simd
+        for (std::size_t c = j + 1; c < k + kb; ++c) dst[c] -= l * src[c];
+      }
+    }
+  }
+
+  void factorize() {
+    const std::size_t n = lu.rows();
+    for (std::size_t k = 0; k < n; k += factor_impl::NB) {
+      const std::size_t kb = std::min(factor_impl::NB, n - k), rest = n - k - kb;
+      factor_panel(k, kb);
+      if (!rest) break;
+
+      // U12 = L11⁻¹ A12
+      MatrixView<T> A = lu.view();
+      factor_impl::forward_subst<T, true>(A.block(k, k, kb, kb), A.block(k, k + kb, kb, rest));
+      // A22 -= L21 · U12
+      gemm<T>(-1, A.block(k + kb, k, rest, kb), A.block(k, k + kb, kb, rest), 1, A.block(k + kb, k + kb, rest, rest));
+    }
+  }
+
+ public:
+  explicit LU(MatrixView<const T> A) : lu(A), piv(A.rows()) {
+    if (A.rows() != A.cols()) throw std::invalid_argument("LU: matrix must be square");
+    factorize();
+  }
+  explicit LU(Matrix<T> &&A) : lu(std::move(A)), piv(lu.rows()) {
+    if (lu.rows() != lu.cols()) throw std::invalid_argument("LU: matrix must be square");
+    factorize();
+  }
+
+  std::size_t      size() const { return lu.rows(); }
+  const Matrix<T> &factors() const { return lu; }
+
+  T determinant() const {
+    T det = sign;
+    for (std::size_t i = 0; i < lu.rows(); ++i) det *= lu(i, i);
+    return det;
+  }
+
+  // solve in place, B (n × nrhs) diganti jadi X dengan A X = B
+  void solve_in_place(MatrixView<T> B) const {
+    if (B.rows() != size()) throw std::invalid_argument("LU::solve: dimension mismatch");
+    for (std::size_t j = 0; j < size(); ++j)
+      if (piv[j] != j)
+        for (std::size_t c = 0; c < B.cols(); ++c) std::swap(B(j, c), B(piv[j], c));
+    factor_impl::forward_subst<T, true>(lu.view(), B);
+    factor_impl::backward_subst<T>(lu.view(), B);
+  }
+
+  void solve_in_place(std::span<T> b) const { solve_in_place(MatrixView<T>(b.data(), b.size(), 1, 1, 1)); }
+
+  Matrix<T> solve(MatrixView<const T> B) const {
+    Matrix<T> X(B);
+    solve_in_place(X.view());
+    return X;
+  }
+
+  std::vector<T> solve(std::span<const T> b) const {
+    std::vector<T> x(b.begin(), b.end());
+    solve_in_place(std::span<T>(x));
+    return x;
+  }
+
+  Matrix<T> inverse() const {
+    Matrix<T> X = Matrix<T>::identity(size());
+    solve_in_place(X.view());
+    return X;
+  }
+};
+
+/* A = L Lᵀ untuk A simetris positive definite, hanya segitiga bawah A yang dibaca.
+ * Sekitar dua kali lebih murah dari LU dan tanpa pivoting.
+ * Kalau A ternyata tidak positive definite melempar std::runtime_error.
+ */
+template <std::floating_point T>
+class Cholesky {
+  Matrix<T> l;
+
+  void factor_diag(std::size_t k, std::size_t kb) {
+    for (std::size_t j = k; j < k + kb; ++j) {
+      T d = l(j, j);
+      for (std::size_t r = k; r < j; ++r) d -= l(j, r) * l(j, r);
+      if (!(d > T(0))) throw std::runtime_error("Cholesky: matrix is not positive definite");
+      l(j, j) = std::sqrt(d);
+      for (std::size_t i = j + 1; i < k + kb; ++i) {
+        T s = l(i, j);
+        for (std::size_t r = k; r < j; ++r) s -= l(i, r) * l(j, r);
+        l(i, j) = s / l(j, j);
+      }
+    }
+  }
+
+  void factorize() {
+    const std::size_t n = l.rows();
+    for (std::size_t k = 0; k < n; k += factor_impl::NB) {
+      const std::size_t kb = std::min(factor_impl::NB, n - k), rest = n - k - kb;
+      factor_diag(k, kb);
+      if (!rest) break;
+
+      // L21 = A21 L11⁻ᵀ, tiap baris independen
+#pragma omp parallel for schedule(static) if (rest > 256)
+      for (std::size_t i = k + kb; i < n; ++i)
+        for (std::size_t j = k; j < k + kb; ++j) {
+          T s = l(i, j);
+          for (std::size_t r = k; r < j; ++r) s -= l(i, r) * l(j, r);
+          l(i, j) = s / l(j, j);
+        }
+
+      /* A22 -= L21 L21ᵀ, cuma segitiga bawah yang dihitung: per blok baris,
+       * kolomnya sampai diagonal saja. Blok baris dibagi ke thread, gemm di
+       * dalamnya serial supaya tidak nested parallel.
+       */
+      MatrixView<T>       A   = l.view();
+      MatrixView<const T> L21 = A.block(k + kb, k, rest, kb);
+      const std::size_t   nbr = (rest + factor_impl::NB - 1) / factor_impl::NB;
+#pragma omp parallel for schedule(dynamic) if (nbr > 1)
+      for (std::size_t b = 0; b < nbr; ++b) {
+        const std::size_t r0 = b * factor_impl::NB, rb = std::min(factor_impl::NB, rest - r0);
+        gemm_impl::gemm<T>(-1, L21.block(r0, 0, rb, kb), L21.block(0, 0, r0 + rb, kb).transposed(), 1, A.block(k + kb + r0, k + kb, rb, r0 + rb), false);
+      }
+    }
+    // segitiga atas cuma sisa input, dinolkan biar factors() benar-benar L
+    for (std::size_t i = 0; i < n; ++i) std::fill(l.row(i).begin() + i + 1, l.row(i).end(), T(0));
+  }
+
+ public:
+  explicit Cholesky(MatrixView<const T> A) : l(A) {
+    if (A.rows() != A.cols()) throw std::invalid_argument("Cholesky: matrix must be square");
+    factorize();
+  }
+  explicit Cholesky(Matrix<T> &&A) : l(std::move(A)) {
+    if (l.rows() != l.cols()) throw std::invalid_argument("Cholesky: matrix must be square");
+    factorize();
+  }
+
+  std::size_t      size() const { return l.rows(); }
+  const Matrix<T> &factors() const { return l; }
+
+  T determinant() const {
+    T det = 1;
+    for (std::size_t i = 0; i < l.rows(); ++i) det *= l(i, i);
+    return det * det;
+  }
+
+  void solve_in_place(MatrixView<T> B) const {
+    if (B.rows() != size()) throw std::invalid_argument("Cholesky::solve: dimension mismatch");
+    factor_impl::forward_subst<T, false>(l.view(), B);
+    factor_impl::backward_subst<T>(l.transposed(), B);
+  }
+
+  void solve_in_place(std::span<T> b) const { solve_in_place(MatrixView<T>(b.data(), b.size(), 1, 1, 1)); }
+
+  Matrix<T> solve(MatrixView<const T> B) const {
+    Matrix<T> X(B);
+    solve_in_place(X.view());
+    return X;
+  }
+
+  std::vector<T> solve(std::span<const T> b) const {
+    std::vector<T> x(b.begin(), b.end());
+    solve_in_place(std::span<T>(x));
+    return x;
+  }
+};
+
+}  // namespace Linear
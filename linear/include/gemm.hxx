@@ -0,0 +1,246 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "aligned.hxx"
+#include "dense_matrix.hxx"
+
+/* GEMM gaya GotoBLAS/BLIS:
+ *   loop jc  (NC kolom C)   → panel B kc × nc dipack sekali, dipakai semua thread
+ *   loop pc  (KC kedalaman)
+ *   loop ic  (MC baris C)   → dibagi ke thread OpenMP, tiap thread pack blok A mc × kc sendiri
+ *   loop jr/ir              → micro-kernel MR × NR yang akumulatornya muat di register
+ * Karena A dan B dipack dulu ke buffer kontigu, layout asal (row/col-major,
+ * transpose) tidak berpengaruh ke micro-kernel, dan loop dalamnya jadi unit
+ * stride sehingga -O3 -march=native bisa vectorize sendiri tanpa intrinsics.
+ */
+
+namespace Linear {
+
+template <std::floating_point T>
+struct GemmBlocking {
+  // NR = dua register vektor AVX2, MR × NR akumulator masih muat di 16 register ymm
+  static constexpr std::size_t NR = 64 / sizeof(T);
+  static constexpr std::size_t MR = 6;
+  // KC × NR panel B muat di L1, MC × KC blok A muat di L2, KC × NC panel B di L3
+  static constexpr std::size_t KC = 256;
+  static constexpr std::size_t MC = 96;
+  static constexpr std::size_t NC = 4096;
+};
+
+namespace gemm_impl {
+
+// pack blok A mc × kc jadi strip MR baris: strip[k * MR + i], baris sisa diisi 0
+template <typename T>
+void pack_A(MatrixView<const T> A, T *dst, std::size_t mr) {
+  const std::size_t mc = A.rows(), kc = A.cols();
+  for (std::size_t i0 = 0; i0 < mc; i0 += mr) {
+    const std::size_t ib = std::min(mr, mc - i0);
+    for (std::size_t k = 0; k < kc; ++k) {
+      for (std::size_t i = 0; i < ib; ++i) dst[k * mr + i] = A(i0 + i, k);
+      for (std::size_t i = ib; i < mr; ++i) dst[k * mr + i] = 0;
+    }
+    dst += mr * kc;
+  }
+}
+
+// pack panel B kc × nc jadi strip NR kolom: strip[k * NR + j], kolom sisa diisi 0
+template <typename T>
+void pack_B(MatrixView<const T> B, T *dst, std::size_t nr, bool parallel) {
+  const std::size_t kc = B.rows(), nc = B.cols(), strips = (nc + nr - 1) / nr;
+#pragma omp parallel for schedule(static) if (parallel)
+  for (std::size_t s = 0; s < strips; ++s) {
+    const std::size_t j0 = s * nr, jb = std::min(nr, nc - j0);
+    T                *out = dst + s * nr * kc;
+    for (std::size_t k = 0; k < kc; ++k) {
+      for (std::size_t j = 0; j < jb; ++j) out[k * nr + j] = B(k, j0 + j);
+      for (std::size_t j = jb; j < nr; ++j) out[k * nr + j] = 0;
+    }
+  }
+}
+
+/* micro-kernel: acc(MR × NR) = Ap(MR × kc) · Bp(kc × NR), lalu
+ * C = alpha * acc + beta * C. Kalau beta == 0 C tidak dibaca sama sekali
+ * (supaya NaN di buffer yang belum diinisialisasi tidak ikut).
+ */
+template <typename T, std::size_t MR, std::size_t NR>
+void micro_kernel(std::size_t kc, const T *__restrict Ap, const T *__restrict Bp, T alpha, T beta, MatrixView<T> C, std::size_t mb, std::size_t nb) {
+  alignas(CACHE_LINE) T acc[MR][NR] = {};
+  for (std::size_t k = 0; k < kc; ++k) {
+    const T *a = Ap + k * MR;
+    const T *b = Bp + k * NR;
+    for (std::size_t i = 0; i < MR; ++i)
+#pragma omp simd
+      for (std::size_t j = 0; j < NR; ++j) acc[i][j] += a[i] * b[j];
+  }
+
+  if (beta == T(0)) {
+    for (std::size_t i = 0; i < mb; ++i)
+      for (std::size_t j = 0; j < nb; ++j) C(i, j) = alpha * acc[i][j];
+  } else {
+    for (std::size_t i = 0; i < mb; ++i)
+      for (std::size_t j = 0; j < nb; ++j) C(i, j) = alpha * acc[i][j] + beta * C(i, j);
+  }
+}
+
+template <typename T>
+void gemm(T alpha, MatrixView<const T> A, MatrixView<const T> B, T beta, MatrixView<T> C, bool parallel) {
+  using BK                 = GemmBlocking<T>;
+  constexpr std::size_t MR = BK::MR, NR = BK::NR;
+  const std::size_t     M = C.rows(), N = C.cols(), K = A.cols();
+
+  if (!M || !N) return;
+  // K = 0 artinya A·B = 0, cukup skala C
+  if (!K || alpha == T(0)) {
+    for (std::size_t i = 0; i < M; ++i)
+      for (std::size_t j = 0; j < N; ++j) C(i, j) = beta == T(0) ? T(0) : beta * C(i, j);
+    return;
+  }
+
+  // buffer pack dipakai ulang antar panggilan, per thread untuk A
+  thread_local aligned_vector<T> packB;
+  packB.resize(BK::KC * ((std::min(BK::NC, N) + NR - 1) / NR * NR));
+  T *const Bp = packB.data();
+
+  for (std::size_t jc = 0; jc < N; jc += BK::NC) {
+    const std::size_t nc = std::min(BK::NC, N - jc);
+    for (std::size_t pc = 0; pc < K; pc += BK::KC) {
+      const std::size_t kc = std::min(BK::KC, K - pc);
+      // beta cuma dipakai di panel k pertama, panel berikutnya akumulasi ke C
+      const T betaEff = pc == 0 ? beta : T(1);
+      pack_B(B.block(pc, jc, kc, nc), Bp, NR, parallel);
+
+      const std::size_t mBlocks = (M + BK::MC - 1) / BK::MC;
+#pragma omp parallel for schedule(dynamic) if (parallel && mBlocks > 1)
+      for (std::size_t mbIdx = 0; mbIdx < mBlocks; ++mbIdx) {
+        const std::size_t              ic = mbIdx * BK::MC, mc = std::min(BK::MC, M - ic);
+        thread_local aligned_vector<T> packA;
+        packA.resize(BK::MC * BK::KC);
+        pack_A(A.block(ic, pc, mc, kc), packA.data(), MR);
+
+        for (std::size_t jr = 0; jr < nc; jr += NR) {
+          const std::size_t nb = std::min(NR, nc - jr);
+          for (std::size_t ir = 0; ir < mc; ir += MR) {
+            const std::size_t mb = std::min(MR, mc - ir);
+            micro_kernel<T, MR, NR>(kc, packA.data() + ir * kc, Bp + jr * kc, alpha, betaEff, C.block(ic + ir, jc + jr, mb, nb), mb, nb);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace gemm_impl
+
+// T cukup dideduksi dari alpha, jadi Matrix bisa langsung dioper tanpa .view()
+template <typename T>
+using view_arg = std::type_identity_t<MatrixView<T>>;
+
+/* C = alpha * A · B + beta * C
+ * A (M × K), B (K × N), C (M × N) boleh layout apa saja, termasuk view transpose.
+ * Dipararelkan dengan OpenMP kalau build pakai -fopenmp.
+ */
+template <std::floating_point T>
+void gemm(T alpha, view_arg<const T> A, view_arg<const T> B, T beta, view_arg<T> C) {
+  if (A.rows() != C.rows() || B.cols() != C.cols() || A.cols() != B.rows()) throw std::invalid_argument("gemm: dimension mismatch");
+  gemm_impl::gemm(alpha, A, B, beta, C, true);
+}
+
+/* y = alpha * A · x + beta * y
+ * Row-major: tiap baris dot product kontigu, baris dibagi ke thread.
+ * Col-major: axpy per kolom, baris dibagi per blok supaya tiap thread punya potongan y sendiri.
+ */
+template <std::floating_point T>
+void gemv(T alpha, view_arg<const T> A, std::type_identity_t<std::span<const T>> x, T beta, std::type_identity_t<std::span<T>> y) {
+  const std::size_t M = A.rows(), N = A.cols();
+  if (x.size() != N || y.size() != M) throw std::invalid_argument("gemv: dimension mismatch");
+
+  if (A.is_row_major()) {
+#pragma omp parallel for schedule(static) if (M * N > (1 << 15))
+    for (std::size_t i = 0; i < M; ++i) {
+      const T *a   = A.data() + i * A.row_stride();
+      T        sum = 0;
+#pragma omp simd reduction(+ : sum)
+      for (std::size_t j = 0; j < N; ++j) sum += a[j] * x[j];
+      y[i] = alpha * sum + (beta == T(0) ? T(0) : beta * y[i]);
+    }
+    return;
+  }
+
+  constexpr std::size_t ROW_BLOCK = 256;
+  const std::size_t     blocks    = (M + ROW_BLOCK - 1) / ROW_BLOCK;
+#pragma omp parallel for schedule(static) if (M * N > (1 << 15))
+  for (std::size_t b = 0; b < blocks; ++b) {
+    const std::size_t i0 = b * ROW_BLOCK, ib = std::min(ROW_BLOCK, M - i0);
+    T                 acc[ROW_BLOCK] = {};
+    for (std::size_t j = 0; j < N; ++j) {
+      const T xj = x[j];
+      for (std::size_t i = 0; i < ib; ++i) acc[i] += A(i0 + i, j) * xj;
+    }
+    for (std::size_t i = 0; i < ib; ++i) y[i0 + i] = alpha * acc[i] + (beta == T(0) ? T(0) : beta * y[i0 + i]);
+  }
+}
+
+/* Banyak GEMM kecil sekaligus (misal satu per sampel atau per head).
+ * Paralel di level batch, masing-masing GEMM jalan serial di threadnya
+ * supaya tidak ada nested parallel region.
+ */
+template <std::floating_point T>
+void gemm_batched(T alpha, std::span<const MatrixView<const T>> A, std::span<const MatrixView<const T>> B, T beta, std::span<const MatrixView<T>> C) {
+  if (A.size() != B.size() || A.size() != C.size()) throw std::invalid_argument("gemm_batched: batch size mismatch");
+  for (std::size_t b = 0; b < A.size(); ++b)
+    if (A[b].rows() != C[b].rows() || B[b].cols() != C[b].cols() || A[b].cols() != B[b].rows())
+      throw std::invalid_argument("gemm_batched: dimension mismatch");
+
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t b = 0; b < A.size(); ++b) gemm_impl::gemm(alpha, A[b], B[b], beta, C[b], false);
+}
+
+// versi strided: batch ke-b ada di A + b * strideA dst, semua dengan ukuran dan layout yang sama
+template <std::floating_point T>
+void gemm_strided_batched(std::size_t count, T alpha, view_arg<const T> A, std::size_t strideA, view_arg<const T> B, std::size_t strideB, T beta,
+                          view_arg<T> C, std::size_t strideC) {
+  if (A.rows() != C.rows() || B.cols() != C.cols() || A.cols() != B.rows()) throw std::invalid_argument("gemm_strided_batched: dimension mismatch");
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t b = 0; b < count; ++b) {
+    MatrixView<const T> Ab(A.data() + b * strideA, A.rows(), A.cols(), A.row_stride(), A.col_stride());
+    MatrixView<const T> Bb(B.data() + b * strideB, B.rows(), B.cols(), B.row_stride(), B.col_stride());
+    MatrixView<T>       Cb(C.data() + b * strideC, C.rows(), C.cols(), C.row_stride(), C.col_stride());
+    gemm_impl::gemm(alpha, Ab, Bb, beta, Cb, false);
+  }
+}
+
+template <std::floating_point T>
+Matrix<T> operator*(const Matrix<T> &a, const Matrix<T> &b) {
+  if (a.cols() != b.rows()) throw std::invalid_argument("Matrix: dimension mismatch on multiplication");
+  Matrix<T> res(a.rows(), b.cols());
+  gemm<T>(1, a, b, 0, res);
+  return res;
+}
+
+}  // namespace Linear
@@ -25,40 +25,65 @@
 #include <cstdlib>
 #include <initializer_list>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "cmath_constexpr.hxx"
+#include "expr.hxx"
 #include "vec.hxx"
 
 namespace Linear {
 
 // example usage Mat<double,4> Matrix 4 * 4 with double element type
 template <std::floating_point T, int N>
-class Mat {
+class Mat : public MatExprTag {
  private:
   T vals[N * N];
 
+  template <typename E>
+  constexpr void assign(const E &e) {
+    for (int i = 0; i < N * N; ++i) vals[i] = static_cast<T>(e.coeff(i));
+  }
+
  public:
-  Mat() : vals() {}
+  using value_type              = T;
+  static constexpr int  size    = N * N;
+  static constexpr int  dim     = N;
+  static constexpr bool is_leaf = true;
+
+  constexpr Mat() : vals() {}
 
   // copy constructor so that we can copy the matrix dirrectly
-  Mat(const Mat &other) = default;
+  constexpr Mat(const Mat &other) = default;
   // copy with assigment operator so that we can copy the matrix without explicitly loopi through the data
-  Mat &operator=(const Mat &other) = default;
+  constexpr Mat &operator=(const Mat &other) = default;
 
-  Mat(T (&v)[N * N]) { set_elements(v); }
-  Mat(const std::initializer_list<T> &v) { set_elements(v); }
-  Mat(T (&v)[N][N]) {
+  constexpr Mat(const T (&v)[N * N]) { set_elements(v); }
+  constexpr Mat(const std::initializer_list<T> &v) { set_elements(v); }
+  constexpr Mat(const T (&v)[N][N]) {
     for (int i = 0; i < N; ++i)
       for (int j = 0; j < N; ++j) vals[N * i + j] = v[i][j];
   }
 
-  void to_array(T (&arr)[N * N]) const {
+  // ekspresi dievaluasi langsung ke vals, objek baru tidak mungkin alias dengan operandnya
+  template <typename E>
+  requires(mat_expr<E> && !std::same_as<expr_t<E>, Mat> && expr_t<E>::dim == N) constexpr Mat(const E &e) { assign(e); }
+
+  template <typename E>
+  requires(mat_expr<E> && !std::same_as<expr_t<E>, Mat> && expr_t<E>::dim == N) constexpr Mat &operator=(const E &e) {
+    // A = B * A misalnya, perkalian baca seluruh baris/kolom A jadi harus dievaluasi dulu
+    if (e.reads_across(this)) return *this = Mat(e);
+    assign(e);
+    return *this;
+  }
+
+  constexpr void to_array(T (&arr)[N * N]) const {
     for (int i = 0; i < N * N; ++i) arr[i] = vals[i];
   }
 
   std::vector<T> to_vector() const { return std::vector<T>(vals, vals + N * N); }
 
-  void set_elements(T (&v)[N * N]) {
+  constexpr void set_elements(const T (&v)[N * N]) {
     for (int i = 0; i < N * N; ++i) vals[i] = v[i];
   }
 
@@ -67,88 +92,198 @@ class Mat {
     for (int i = 0; i < N * N; ++i) vals[i] = v[i];
   }
 
-  void set_elements(const std::initializer_list<T> &v) {
+  constexpr void set_elements(const std::initializer_list<T> &v) {
     assert(v.size() == N * N);
     auto it = v.begin();
     // tricky menambah i bersamaan dengan menambah iterator it
     for (int i = 0; i < N * N; ++i, ++it) vals[i] = *it;
   }
 
-  void set_identity() {
+  constexpr void set_identity() {
     for (int row = 0; row < N; ++row)
       for (int col = 0; col < N; ++col)
         if (row == col) vals[row * N + col] = 1.0;
         else vals[row * N + col] = 0;
   }
 
-  void set_element(size_t i, T val) { vals[i] = val; }
+  constexpr void set_element(size_t i, T val) { vals[i] = val; }
 
-  template <typename U>
-  requires(std::integral<T> || std::floating_point<T>) Mat operator*(U c) const {
-    T vals_cp[N * N];
-    for (int i = 0; i < N * N; ++i) vals_cp[i] = vals[i] * c;
-    return Mat(vals_cp);
-  }
+  constexpr T        coeff(int i) const { return vals[i]; }
+  constexpr bool     reads_across(const void *) const { return false; }
+  constexpr T       &operator()(int row, int col) { return vals[row * N + col]; }
+  constexpr const T &operator()(int row, int col) const { return vals[row * N + col]; }
 
-  Vec<T, N> operator[](int row) const {
+  constexpr Vec<T, N> operator[](int row) const {
     assert(row >= 0 && row < N);
     Vec<T, N> res;
     for (int col = 0; col < N; ++col) res[col] = vals[row * N + col];
     return res;
   }
 
-  template <typename U>  // all of the number type are accept, but doesnt need to check the value is number or not since the vec class already handle it
-  Vec<T, N> operator*(const Vec<U, N> &vn) const {
-    Vec<T, N> res;
-    for (int row = 0; row < N; ++row)
-      for (int col = 0; col < N; ++col) res[row] += vals[row * N + col] * static_cast<T>(vn[col]);
-    return res;
+  // overload juga penugasannya agar lebih mudah, semuanya in place tanpa Mat sementara
+#define OV_ASSIGNMENT_OP(op)                                                               \
+  template <typename E>                                                                    \
+  requires(mat_expr<E> && expr_t<E>::dim == N) constexpr Mat &operator op##=(const E &m) { \
+    if (m.reads_across(this)) return *this op##= Mat(m);                                   \
+    for (int i = 0; i < N * N; ++i) vals[i] op##= static_cast<T>(m.coeff(i));              \
+    return *this;                                                                          \
   }
 
-  template <typename U>
-  Mat operator*(const Mat<U, N> &m) const {
-    T vals_res[N * N]{};
-    // k ini faktor untuk ngurusin perkaliannya
-    // sedangkan row dan col untuk indeks hasil akhirnya
-    for (int row = 0; row < N; ++row)
-      for (int col = 0; col < N; ++col)
-        for (int k = 0; k < N; ++k) vals_res[row * N + col] += vals[row * N + k] * static_cast<T>(m[k][col]);
+  /* nambah ; sebenernya ga perlu tapi karena vim indentnya bakal ga sejajar
+   * lagi jadi ditambahin ;
+   */
+  OV_ASSIGNMENT_OP(+);
+  OV_ASSIGNMENT_OP(-);
+#undef OV_ASSIGNMENT_OP
 
-    return Mat(vals_res);
+  template <typename S>
+  requires(scalar<S>) constexpr Mat &operator*=(S c) {
+    for (int i = 0; i < N * N; ++i) vals[i] *= static_cast<T>(c);
+    return *this;
   }
 
-  template <typename U>
-  Mat operator+(const Mat<U, N> &m) const {
-    T vals_res[N * N]{};
-    for (int i = 0; i < N * N; ++i) vals_res[i] = vals[i] + static_cast<T>(m[i / N][i % N]);
-    return Mat(vals_res);
+  template <typename S>
+  requires(scalar<S>) constexpr Mat &operator/=(S c) {
+    for (int i = 0; i < N * N; ++i) vals[i] /= static_cast<T>(c);
+    return *this;
   }
 
-  template <typename U>
-  Mat operator-(const Mat<U, N> &m) const {
-    T vals_res[N * N]{};
-    for (int i = 0; i < N * N; ++i) vals_res[i] = vals[i] - static_cast<T>(m[i / N][i % N]);
-    return Mat(vals_res);
+  /* A *= B dikerjakan per baris, tiap baris A disalin dulu ke buffer N elemen
+   * karena baris hasil bergantung ke seluruh baris A yang lama
+   */
+  template <typename E>
+  requires(mat_expr<E> && expr_t<E>::dim == N) constexpr Mat &operator*=(const E &m) {
+    if constexpr (!std::same_as<expr_t<E>, Mat>) return *this *= Mat(m);
+    else {
+      if (&m == this) return *this *= Mat(m);
+      T row_cp[N];
+      for (int row = 0; row < N; ++row) {
+        for (int k = 0; k < N; ++k) row_cp[k] = vals[row * N + k];
+        for (int col = 0; col < N; ++col) {
+          T sum = 0;
+          for (int k = 0; k < N; ++k) sum += row_cp[k] * m.vals[k * N + col];
+          vals[row * N + col] = sum;
+        }
+      }
+      return *this;
+    }
   }
 
-  // overload juga penugasannya agar lebih mudah
-#define OV_ASSIGNMENT_OP(op)                \
-  template <typename U>                     \
-  Mat &operator op##=(const Mat<U, N> &m) { \
-    return *this = *this op m;              \
+  /* N = 2, 3, 4 pakai rumus kofaktor langsung (tanpa pivot, tanpa cabang),
+   * selain itu eliminasi gauss dengan partial pivoting
+   */
+  constexpr T determinant() const {
+    const T *m = vals;
+    if constexpr (N == 2) return m[0] * m[3] - m[1] * m[2];
+    else if constexpr (N == 3) return m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6]) + m[2] * (m[3] * m[7] - m[4] * m[6]);
+    else if constexpr (N == 4) {
+      T s[6], c[6];
+      minors_2x2(s, c);
+      return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+    } else return determinant_gauss();
   }
 
-  /* nambah ; sebenernya ga perlu tapi karena vim indentnya bakal ga sejajar
-   * lagi jadi ditambahin ;
+  constexpr Mat transpose() const {
+    // tukar baris menjadi kolom dan kolom menjadi baris
+    T tmpvals[N * N];
+    for (int i = 0; i < N; ++i)
+      for (int j = 0; j < N; ++j) tmpvals[i * N + j] = vals[j * N + i];
+    return Mat(tmpvals);
+  }
+
+  /* N = 2, 3 adjugate / det, N = 4 juga adjugate tapi dicek dulu apakah
+   * matriksnya affine (baris terakhir 0 0 0 1, atau kolom terakhir untuk
+   * layout transpose seperti VIEW_MATRIX), kalau iya cukup invers blok 3×3.
    */
-  OV_ASSIGNMENT_OP(*);
-  OV_ASSIGNMENT_OP(/);
-  OV_ASSIGNMENT_OP(+);
-  OV_ASSIGNMENT_OP(-);
-#undef OV_ASSIGNMENT_OP
+  constexpr Mat inverse() const {
+    const T *m = vals;
+    if constexpr (N == 2) {
+      const T det = determinant();
+      if (det == 0) throw std::runtime_error("Singular matrix");
+      const T inv = 1 / det;
+      return Mat({m[3] * inv, -m[1] * inv, -m[2] * inv, m[0] * inv});
+    } else if constexpr (N == 3) {
+      T adj[9] = {m[4] * m[8] - m[5] * m[7], m[2] * m[7] - m[1] * m[8], m[1] * m[5] - m[2] * m[4],
+                  m[5] * m[6] - m[3] * m[8], m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+                  m[3] * m[7] - m[4] * m[6], m[1] * m[6] - m[0] * m[7], m[0] * m[4] - m[1] * m[3]};
+      // det dari ekspansi baris pertama, kofaktornya sudah ada di kolom pertama adj
+      const T det = m[0] * adj[0] + m[1] * adj[3] + m[2] * adj[6];
+      if (det == 0) throw std::runtime_error("Singular matrix");
+      const T inv = 1 / det;
+      for (T &v : adj) v *= inv;
+      return Mat(adj);
+    } else if constexpr (N == 4) {
+      if (is_affine()) return affine_inverse();
+      if (m[3] == 0 && m[7] == 0 && m[11] == 0 && m[15] == 1) return transpose().affine_inverse().transpose();
+      T s[6], c[6];
+      minors_2x2(s, c);
+      const T det = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+      if (det == 0) throw std::runtime_error("Singular matrix");
+      const T inv = 1 / det;
+      T       res[16] = {
+          (m[5] * c[5] - m[6] * c[4] + m[7] * c[3]) * inv,   (-m[1] * c[5] + m[2] * c[4] - m[3] * c[3]) * inv,
+          (m[13] * s[5] - m[14] * s[4] + m[15] * s[3]) * inv, (-m[9] * s[5] + m[10] * s[4] - m[11] * s[3]) * inv,
+          (-m[4] * c[5] + m[6] * c[2] - m[7] * c[1]) * inv,  (m[0] * c[5] - m[2] * c[2] + m[3] * c[1]) * inv,
+          (-m[12] * s[5] + m[14] * s[2] - m[15] * s[1]) * inv, (m[8] * s[5] - m[10] * s[2] + m[11] * s[1]) * inv,
+          (m[4] * c[4] - m[5] * c[2] + m[7] * c[0]) * inv,   (-m[0] * c[4] + m[1] * c[2] - m[3] * c[0]) * inv,
+          (m[12] * s[4] - m[13] * s[2] + m[15] * s[0]) * inv, (-m[8] * s[4] + m[9] * s[2] - m[11] * s[0]) * inv,
+          (-m[4] * c[3] + m[5] * c[1] - m[6] * c[0]) * inv,  (m[0] * c[3] - m[1] * c[1] + m[2] * c[0]) * inv,
+          (-m[12] * s[3] + m[13] * s[1] - m[14] * s[0]) * inv, (m[8] * s[3] - m[9] * s[1] + m[10] * s[0]) * inv};
+      return Mat(res);
+    } else return inverse_gauss_jordan();
+  }
+
+  // baris terakhir persis 0 0 0 1, translasi ada di kolom terakhir (konvensi model matrix)
+  constexpr bool is_affine() const requires(N == 4) { return vals[12] == 0 && vals[13] == 0 && vals[14] == 0 && vals[15] == 1; }
+
+  /* invers [A | t] = [A⁻¹ | -A⁻¹ t], cuma butuh invers 3×3.
+   * Hanya valid kalau is_affine(), tidak dicek ulang di sini.
+   */
+  constexpr Mat affine_inverse() const requires(N == 4) {
+    const Mat<T, 3> a = Mat<T, 3>({vals[0], vals[1], vals[2], vals[4], vals[5], vals[6], vals[8], vals[9], vals[10]}).inverse();
+    return affine_from(a);
+  }
+
+  /* untuk transformasi rigid (rotasi ortonormal + translasi) A⁻¹ = Aᵀ,
+   * jadi bahkan tidak ada pembagian sama sekali
+   */
+  constexpr Mat rigid_inverse() const requires(N == 4) {
+    const Mat<T, 3> a({vals[0], vals[4], vals[8], vals[1], vals[5], vals[9], vals[2], vals[6], vals[10]});
+    return affine_from(a);
+  }
+
+ private:
+  // [a | -a t] dengan t kolom translasi matriks ini
+  constexpr Mat affine_from(const Mat<T, 3> &a) const requires(N == 4) {
+    const T tx = vals[3], ty = vals[7], tz = vals[11];
+    Mat     res;
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 3; ++c) res.vals[r * 4 + c] = a(r, c);
+      res.vals[r * 4 + 3] = -(a(r, 0) * tx + a(r, 1) * ty + a(r, 2) * tz);
+    }
+    res.vals[15] = 1;
+    return res;
+  }
+
+  // determinan 2×2 dari dua baris atas (s) dan dua baris bawah (c), dipakai det dan inverse 4×4
+  constexpr void minors_2x2(T (&s)[6], T (&c)[6]) const requires(N == 4) {
+    const T *m = vals;
+    s[0]       = m[0] * m[5] - m[4] * m[1];
+    s[1]       = m[0] * m[6] - m[4] * m[2];
+    s[2]       = m[0] * m[7] - m[4] * m[3];
+    s[3]       = m[1] * m[6] - m[5] * m[2];
+    s[4]       = m[1] * m[7] - m[5] * m[3];
+    s[5]       = m[2] * m[7] - m[6] * m[3];
+    c[5]       = m[10] * m[15] - m[14] * m[11];
+    c[4]       = m[9] * m[15] - m[13] * m[11];
+    c[3]       = m[9] * m[14] - m[13] * m[10];
+    c[2]       = m[8] * m[15] - m[12] * m[11];
+    c[1]       = m[8] * m[14] - m[12] * m[10];
+    c[0]       = m[8] * m[13] - m[12] * m[9];
+  }
 
   // eliminasi gauss
-  T determinant() const {
+  constexpr T determinant_gauss() const {
     T det = 1;
     T tmpvals[N * N];
     to_array(tmpvals);
@@ -156,7 +291,7 @@ class Mat {
       // cari baris dengan elemen terbesar di kolom i (pivoting)
       int maxRow = i;
       for (int j = i + 1; j < N; ++j)
-        if (std::abs(tmpvals[j * N + i]) > std::abs(tmpvals[maxRow * N + i])) maxRow = j;
+        if (cx::abs(tmpvals[j * N + i]) > cx::abs(tmpvals[maxRow * N + i])) maxRow = j;
       // tukar baris i dengan baris maxRow jika perlu
       if (i != maxRow) {
         for (int k = 0; k < N; ++k) std::swap(tmpvals[i * N + k], tmpvals[maxRow * N + k]);
@@ -175,15 +310,7 @@ class Mat {
     return det;
   }
 
-  Mat transpose() const {
-    // tukar baris menjadi kolom dan kolom menjadi baris
-    T tmpvals[N * N];
-    for (int i = 0; i < N; ++i)
-      for (int j = 0; j < N; ++j) tmpvals[i * N + j] = vals[j * N + i];
-    return Mat(tmpvals);
-  }
-
-  Mat inverse() const {
+  constexpr Mat inverse_gauss_jordan() const {
     T res[N][N], tmp[N][N];
     for (int i = 0; i < N; ++i)
       for (int j = 0; j < N; ++j) {
@@ -194,7 +321,7 @@ class Mat {
     for (int i = 0; i < N; ++i) {
       int pivot = i;
       for (int j = i + 1; j < N; ++j)
-        if (std::abs(tmp[j][i]) > std::abs(tmp[pivot][i])) pivot = j;
+        if (cx::abs(tmp[j][i]) > cx::abs(tmp[pivot][i])) pivot = j;
       if (tmp[pivot][i] == 0) throw std::runtime_error("Singular matrix");
 
       for (int k = 0; k < N; ++k) {
@@ -220,7 +347,10 @@ class Mat {
 
     return Mat(res);
   }
-  T *data() { return vals; }
+
+ public:
+  constexpr T       *data() { return vals; }
+  constexpr const T *data() const { return vals; }
 };
 
 // usage Mat3<double> or Mat3<float>
@@ -234,31 +364,79 @@ using Mat4f = Mat<float, 4>;
 using Mat3d = Mat<double, 3>;
 using Mat4d = Mat<double, 4>;
 
-// agar komutatif
-template <typename T, int N>
-Mat<T, N> operator*(const T fp, const Mat<T, N> &m) {
-  return m * fp;
+/* Node perkalian matriks. Beda dengan element-wise, coeff(i) butuh satu baris
+ * lhs dan satu kolom rhs, jadi operand yang masih berupa ekspresi dievaluasi
+ * sekali ke Mat (kalau tidak, tiap elemennya dihitung ulang N kali). Mat
+ * lvalue tetap disimpan referensinya, hasil akhirnya ditulis langsung ke
+ * tujuan saat assignment.
+ */
+template <typename E>
+using product_store_t = std::conditional_t<std::is_lvalue_reference_v<E> && expr_t<E>::is_leaf, const expr_t<E> &,
+                                           Mat<typename expr_t<E>::value_type, expr_t<E>::dim>>;
+
+template <typename L, typename R>
+class MatProduct : public MatExprTag {
+  product_store_t<L> l;
+  product_store_t<R> r;
+
+ public:
+  using value_type              = typename expr_t<L>::value_type;
+  static constexpr int  dim     = expr_t<L>::dim;
+  static constexpr int  size    = dim * dim;
+  static constexpr bool is_leaf = false;
+
+  template <typename A, typename B>
+  constexpr MatProduct(A &&a, B &&b) : l(std::forward<A>(a)), r(std::forward<B>(b)) {}
+
+  constexpr value_type coeff(int i) const {
+    const int  row = i / dim, col = i % dim;
+    value_type sum = 0;
+    // k ini faktor untuk ngurusin perkaliannya
+    for (int k = 0; k < dim; ++k) sum += l.coeff(row * dim + k) * static_cast<value_type>(r.coeff(k * dim + col));
+    return sum;
+  }
+
+  constexpr bool reads_across(const void *p) const {
+    return static_cast<const void *>(&l) == p || static_cast<const void *>(&r) == p;
+  }
+};
+
+template <typename L, typename R>
+requires(mat_expr<L> && mat_expr<R> && expr_t<L>::dim == expr_t<R>::dim) constexpr auto operator*(L &&l, R &&r) {
+  return MatProduct<L, R>(std::forward<L>(l), std::forward<R>(r));
+}
+
+// Mat * Vec langsung menghasilkan Vec, hasilnya kecil jadi tidak perlu lazy
+template <typename M, typename V>
+requires(mat_expr<M> && vec_expr<V> && expr_t<M>::dim == expr_t<V>::size) constexpr auto operator*(const M &m, const V &vn) {
+  using T         = typename expr_t<M>::value_type;
+  constexpr int N = expr_t<M>::dim;
+  const Vec<T, N> v(vn);
+  Vec<T, N>       res;
+  for (int row = 0; row < N; ++row)
+    for (int col = 0; col < N; ++col) res[row] += m.coeff(row * N + col) * v[col];
+  return res;
 }
 
 // untuk mengubah matriks 3×3 ke 4×4
-template <typename T>
-Mat<T, 4> mat3_to_mat4(const Mat<T, 3> &m) {
+template <typename E>
+requires(mat_expr<E> && expr_t<E>::dim == 3) constexpr auto mat3_to_mat4(const E &m) {
+  using T = typename expr_t<E>::value_type;
   T res_arr[4 * 4];
   for (int i = 0; i < 16; ++i) {
     if ((i & 3) == 3 || (i >> 2) == 3) res_arr[i] = (i == 15) ? 1 : 0;
-    else res_arr[i] = m[i >> 2][i & 3];
+    else res_arr[i] = m.coeff((i >> 2) * 3 + (i & 3));
   }
   return Mat<T, 4>(res_arr);
 }
 
 // untuk trim matrix 4×4 ke 3×3
-template <typename T>
-Mat<T, 3> mat4_to_mat3(const Mat<T, 4> &m) {
+template <typename E>
+requires(mat_expr<E> && expr_t<E>::dim == 4) constexpr auto mat4_to_mat3(const E &m) {
+  using T = typename expr_t<E>::value_type;
   T res_arr[3 * 3];
-  for (int i = 0; i < 9; ++i) {
-    if ((i & 3) == 2 || (i >> 2) == 2) res_arr[i] = 0;  // menghilangkan kolom dan baris ke-3
-    else res_arr[i] = m[i >> 2][i & 3];
-  }
+  // buang kolom dan baris ke-3 (komponen w)
+  for (int i = 0; i < 9; ++i) res_arr[i] = m.coeff((i / 3) * 4 + i % 3);
   return Mat<T, 3>(res_arr);
 }
 
@@ -266,14 +444,14 @@ Mat<T, 3> mat4_to_mat3(const Mat<T, 4> &m) {
  * rubah dulu yang 3×3 ke 4×4 dengan menambahkan komponen w
  */
 template <typename T>
-Mat<T, 4> operator*(const Mat<T, 4> &a, const Mat<T, 3> &b) {
-  return a * mat3_to_mat4<T>(b);
+constexpr Mat<T, 4> operator*(const Mat<T, 4> &a, const Mat<T, 3> &b) {
+  return a * mat3_to_mat4(b);
 }
 
 // agar berlaku sebaliknya juga
 template <typename T>
-Mat<T, 4> operator*(const Mat<T, 3> &a, const Mat<T, 4> &b) {
-  return mat3_to_mat4<T>(a) * b;
+constexpr Mat<T, 4> operator*(const Mat<T, 3> &a, const Mat<T, 4> &b) {
+  return mat3_to_mat4(a) * b;
 }
 
 // bakal berguna nanti buat kelas kelas seperti kamera objek atau proyeksi
@@ -285,7 +463,7 @@ enum EULER_ROTATION_TYPE { ZYX, ZXY, YXZ, YZX, XZY, XYZ };
 
 // View matrix
 template <typename T>
-Mat<T, 4> VIEW_MATRIX(const Vec3<T> &eye, const Vec3<T> &center, const Vec3<T> &up = {0, 1, 0}, const Vec3<T> &t = {0, 0, 0}) {
+constexpr Mat<T, 4> VIEW_MATRIX(const Vec3<T> &eye, const Vec3<T> &center, const Vec3<T> &up = {0, 1, 0}, const Vec3<T> &t = {0, 0, 0}) {
   // Forward, Right, dan Up vector
   Vec3<T> f = normalize(center - eye);  // forward vector
   Vec3<T> r = normalize(cross(f, up));  // right vector
@@ -297,32 +475,32 @@ Mat<T, 4> VIEW_MATRIX(const Vec3<T> &eye, const Vec3<T> &center, const Vec3<T> &
 
 // Perspective Matrix
 template <typename T>
-Mat<T, 4> PERSPECTIVE_MATRIX(T Fov, T a, T n, T f) {
-  T tan_half_fov = std::tan(Fov / 2);
+constexpr Mat<T, 4> PERSPECTIVE_MATRIX(T Fov, T a, T n, T f) {
+  T tan_half_fov = cx::tan(Fov / 2);
   return Mat<T, 4>({1 / (tan_half_fov * a), 0, 0, 0, 0, 1 / tan_half_fov, 0, 0, 0, 0, (f + n) / (f - n), 2 * f * n / (f - n), 0, 0, -1, 0});
 }
 
 // Orthographic Matrix
 template <typename T>
-Mat<T, 4> ORTHOGRAPHIC_MATRIX(T l, T r, T t, T b, T n, T f) {
+constexpr Mat<T, 4> ORTHOGRAPHIC_MATRIX(T l, T r, T t, T b, T n, T f) {
   return Mat<T, 4>({2 / (r - l), 0, 0, -(r + l) / (r - l), 0, 2 / (t - b), 0, -(t + b) / (t - b), 0, 0, -2 / (f - n), -(f + n) / (f - n), 0, 0, 0, 1});
 }
 
 // Frustum Matrix
 template <typename T>
-Mat<T, 4> FRUSTUM_MATRIX(T l, T r, T t, T b, T n, T f) {
+constexpr Mat<T, 4> FRUSTUM_MATRIX(T l, T r, T t, T b, T n, T f) {
   return Mat<T, 4>(
       {(2 * n) / (r - l), 0, (r + l) / (r - l), 0, 0, (2 * n) / (t - b), (t + b) / (t - b), 0, 0, 0, (f + n) / (f - n), (2 * f * n) / (f - n), 0, 0, -1, 0});
 }
 
 template <typename T>
-Mat<T, 3> EULER_ROTATION_MATRIX(const Vec3<T> &rad, const EULER_ROTATION_TYPE &rt) {
+constexpr Mat<T, 3> EULER_ROTATION_MATRIX(const Vec3<T> &rad, const EULER_ROTATION_TYPE &rt) {
   // semua rotasi bergantung pada global axis
   // Urutan terbalik karena Matrix selalu lhs terhadap objek
   // rotasi di sumbu x
-  T cos_x = std::cos(rad.x()), sin_x = std::sin(rad.x());
-  T cos_y = std::cos(rad.y()), sin_y = std::sin(rad.y());
-  T cos_z = std::cos(rad.z()), sin_z = std::sin(rad.z());
+  T cos_x = cx::cos(rad.x()), sin_x = cx::sin(rad.x());
+  T cos_y = cx::cos(rad.y()), sin_y = cx::sin(rad.y());
+  T cos_z = cx::cos(rad.z()), sin_z = cx::sin(rad.z());
 
   Mat<T, 3> Rx{1, 0, 0, 0, cos_x, -sin_x, 0, sin_x, cos_x};
   // rotasi di sumbu y
@@ -337,11 +515,12 @@ Mat<T, 3> EULER_ROTATION_MATRIX(const Vec3<T> &rad, const EULER_ROTATION_TYPE &r
     case XZY: return Rx * Rz * Ry;
     case XYZ: return Rz * Ry * Rx;
   }
+  return Mat<T, 3>();
 }
 
 template <typename T>
-Mat<T, 3> QUATERNION_MATRIX(const Vec3<T> &v, T rad) {
-  T s = static_cast<T>(sin(rad / 2)), c = static_cast<T>(cos(rad / 2)), x = v.x() * s, y = v.y() * s, z = v.z() * s;
+constexpr Mat<T, 3> QUATERNION_MATRIX(const Vec3<T> &v, T rad) {
+  T s = cx::sin(rad / 2), c = cx::cos(rad / 2), x = v.x() * s, y = v.y() * s, z = v.z() * s;
 
   // Matriks quaternion dihitung
   T mat[9] = {
@@ -0,0 +1,195 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "aligned.hxx"
+#include "matrix.hxx"
+#include "vec.hxx"
+
+/* Transformasi banyak vertex sekaligus dalam layout structure-of-arrays.
+ * Dengan x, y, z di array terpisah, satu iterasi SIMD memproses LANES vertex
+ * (16 float / 8 double untuk 64 byte = satu register AVX-512 atau dua AVX2),
+ * koefisien matriks cukup di-broadcast sekali. Mesh besar dibagi per chunk
+ * ke thread OpenMP, chunk kecil dikerjakan serial karena overhead thread
+ * lebih mahal dari kerjanya.
+ */
+
+namespace Linear {
+
+template <std::floating_point T>
+struct PointsSoA {
+  aligned_vector<T> x, y, z;
+
+  PointsSoA() = default;
+  explicit PointsSoA(std::size_t n) : x(n), y(n), z(n) {}
+
+  std::size_t size() const { return x.size(); }
+  void        resize(std::size_t n) {
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+  }
+};
+
+namespace transform_impl {
+
+template <typename T>
+inline constexpr std::size_t LANES = CACHE_LINE / sizeof(T);
+// jumlah vertex per chunk thread, kira-kira 3 × 16K × 4 byte = 192KB in + out masih muat di L2
+inline constexpr std::size_t CHUNK = 16384;
+
+/* kerjakan [begin, end), m dibaca sebagai koefisien skalar di register.
+ * Rows = 3 untuk affine (w diasumsikan 1 dan baris ke-4 diabaikan), 4 untuk homogen penuh.
+ */
+template <typename T, int Rows, bool Translate>
+void transform_range(const T (&m)[16], const T *xs, const T *ys, const T *zs, T *ox, T *oy,
+                     T *oz, T *ow, std::size_t begin, std::size_t end) {
+  const T m00 = m[0], m01 = m[1], m02 = m[2], m03 = Translate ? m[3] : T(0);
+  const T m10 = m[4], m11 = m[5], m12 = m[6], m13 = Translate ? m[7] : T(0);
+  const T m20 = m[8], m21 = m[9], m22 = m[10], m23 = Translate ? m[11] : T(0);
+  const T m30 = m[12], m31 = m[13], m32 = m[14], m33 = m[15];
+
+  std::size_t i = begin;
+  // blok penuh LANES vertex, ini yang jadi satu (atau dua) instruksi vektor per operasi
+  for (; i + LANES<T> <= end; i += LANES<T>) {
+#pragma omp simd
+    for (std::size_t l = i; l < i + LANES<T>; ++l) {
+      const T x = xs[l], y = ys[l], z = zs[l];
+      ox[l]     = m00 * x + m01 * y + m02 * z + m03;
+      oy[l]     = m10 * x + m11 * y + m12 * z + m13;
+      oz[l]     = m20 * x + m21 * y + m22 * z + m23;
+      if constexpr (Rows == 4) ow[l] = m30 * x + m31 * y + m32 * z + m33;
+    }
+  }
+  // sisa ekor
+  for (; i < end; ++i) {
+    const T x = xs[i], y = ys[i], z = zs[i];
+    ox[i]     = m00 * x + m01 * y + m02 * z + m03;
+    oy[i]     = m10 * x + m11 * y + m12 * z + m13;
+    oz[i]     = m20 * x + m21 * y + m22 * z + m23;
+    if constexpr (Rows == 4) ow[i] = m30 * x + m31 * y + m32 * z + m33;
+  }
+}
+
+template <typename T, int Rows, bool Translate>
+void transform_all(const T (&m)[16], std::span<const T> xs, std::span<const T> ys, std::span<const T> zs, std::span<T> ox, std::span<T> oy, std::span<T> oz,
+                   T *ow) {
+  const std::size_t n = xs.size();
+  if (ys.size() != n || zs.size() != n || ox.size() < n || oy.size() < n || oz.size() < n)
+    throw std::invalid_argument("transform_points: input/output size mismatch");
+
+  const std::size_t chunks = (n + CHUNK - 1) / CHUNK;
+#pragma omp parallel for schedule(static) if (chunks > 1)
+  for (std::size_t c = 0; c < chunks; ++c)
+    transform_range<T, Rows, Translate>(m, xs.data(), ys.data(), zs.data(), ox.data(), oy.data(), oz.data(), ow, c * CHUNK, std::min(n, (c + 1) * CHUNK));
+}
+
+template <typename T>
+void load(const Mat<T, 4> &mat, T (&m)[16]) {
+  for (int i = 0; i < 16; ++i) m[i] = mat.coeff(i);
+}
+
+template <typename T>
+void load(const Mat<T, 3> &mat, T (&m)[16]) {
+  for (int i = 0; i < 16; ++i) m[i] = (i & 3) == 3 || (i >> 2) == 3 ? T(i == 15) : mat.coeff((i >> 2) * 3 + (i & 3));
+}
+
+template <typename T>
+using span_arg = std::type_identity_t<std::span<T>>;
+
+}  // namespace transform_impl
+
+/* out = m · (x, y, z, 1), hanya tiga baris pertama (affine, misal model matrix).
+ * Output boleh sama dengan input (in place) karena tiap vertex dibaca sebelum ditulis.
+ */
+template <std::floating_point T>
+void transform_points(const Mat<T, 4> &m, transform_impl::span_arg<const T> xs, transform_impl::span_arg<const T> ys, transform_impl::span_arg<const T> zs,
+                      transform_impl::span_arg<T> outX, transform_impl::span_arg<T> outY, transform_impl::span_arg<T> outZ) {
+  T coef[16];
+  transform_impl::load(m, coef);
+  transform_impl::transform_all<T, 3, true>(coef, xs, ys, zs, outX, outY, outZ, nullptr);
+}
+
+// versi homogen penuh, w ikut ditulis (untuk proyeksi, pembagian perspektif diserahkan ke caller)
+template <std::floating_point T>
+void transform_points(const Mat<T, 4> &m, transform_impl::span_arg<const T> xs, transform_impl::span_arg<const T> ys, transform_impl::span_arg<const T> zs,
+                      transform_impl::span_arg<T> outX, transform_impl::span_arg<T> outY, transform_impl::span_arg<T> outZ, transform_impl::span_arg<T> outW) {
+  if (outW.size() < xs.size()) throw std::invalid_argument("transform_points: output w too small");
+  T coef[16];
+  transform_impl::load(m, coef);
+  transform_impl::transform_all<T, 4, true>(coef, xs, ys, zs, outX, outY, outZ, outW.data());
+}
+
+// rotasi/skala saja tanpa translasi, cocok juga untuk normal (dengan matriks inverse-transpose)
+template <std::floating_point T>
+void transform_points(const Mat<T, 3> &m, transform_impl::span_arg<const T> xs, transform_impl::span_arg<const T> ys, transform_impl::span_arg<const T> zs,
+                      transform_impl::span_arg<T> outX, transform_impl::span_arg<T> outY, transform_impl::span_arg<T> outZ) {
+  T coef[16];
+  transform_impl::load(m, coef);
+  transform_impl::transform_all<T, 3, false>(coef, xs, ys, zs, outX, outY, outZ, nullptr);
+}
+
+template <std::floating_point T, int N>
+requires(N == 3 || N == 4) void transform_points(const Mat<T, N> &m, const PointsSoA<T> &in, PointsSoA<T> &out) {
+  if (&in != &out) out.resize(in.size());
+  transform_points<T>(m, in.x, in.y, in.z, out.x, out.y, out.z);
+}
+
+// ===== konversi AoS (std::vector<Vec3<T>>) <-> SoA =====
+
+template <std::floating_point T>
+void aos_to_soa(std::span<const Vec3<T>> in, PointsSoA<T> &out) {
+  const std::size_t n = in.size();
+  out.resize(n);
+#pragma omp parallel for schedule(static) if (n > transform_impl::CHUNK)
+  for (std::size_t i = 0; i < n; ++i) {
+    out.x[i] = in[i][0];
+    out.y[i] = in[i][1];
+    out.z[i] = in[i][2];
+  }
+}
+
+template <std::floating_point T>
+PointsSoA<T> aos_to_soa(std::span<const Vec3<T>> in) {
+  PointsSoA<T> res;
+  aos_to_soa<T>(in, res);
+  return res;
+}
+
+template <std::floating_point T>
+void soa_to_aos(const PointsSoA<T> &in, std::span<Vec3<T>> out) {
+  const std::size_t n = in.size();
+  if (out.size() < n) throw std::invalid_argument("soa_to_aos: output too small");
+#pragma omp parallel for schedule(static) if (n > transform_impl::CHUNK)
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i][0] = in.x[i];
+    out[i][1] = in.y[i];
+    out[i][2] = in.z[i];
+  }
+}
+
+}  // namespace Linear
@@ -24,44 +24,65 @@
 #include <concepts>
 #include <initializer_list>
 
+#include "cmath_constexpr.hxx"
+#include "expr.hxx"
+
 namespace Linear {
 
 template <typename T, int N>
-requires(std::integral<T> || std::floating_point<T>) class Vec {
+requires(std::integral<T> || std::floating_point<T>) class Vec : public VecExprTag {
  private:
   T val[N];
 
+  template <typename E>
+  constexpr void assign(const E &e) {
+    for (int i = 0; i < N; ++i) val[i] = static_cast<T>(e.coeff(i));
+  }
+
  public:
-  Vec() : val() {}
+  using value_type              = T;
+  static constexpr int  size    = N;
+  static constexpr int  dim     = N;
+  static constexpr bool is_leaf = true;
 
-  Vec(std::initializer_list<T> list) {
+  constexpr Vec() : val() {}
+
+  constexpr Vec(std::initializer_list<T> list) {
     assert(list.size() == N);
     auto it = list.begin();
     for (int i = 0; i < N; ++i, ++it) val[i] = *it;
   }
 
-  Vec(T (&arr)[N]) {
+  constexpr Vec(const T (&arr)[N]) {
     for (int i = 0; i < N; ++i) val[i] = arr[i];
   }
 
-#define VEC_BASE_OPERATOR(op)                                             \
-  template <typename U>                                                   \
-  Vec operator op(const Vec<U, N> &vn) const {                            \
-    Vec<T, N> res;                                                        \
-    for (int i = 0; i < N; ++i) res[i] = val[i] op static_cast<T>(vn[i]); \
-    return res;                                                           \
-  }
+  // evaluasi ekspresi langsung ke storage, tanpa Vec sementara
+  template <typename E>
+  requires(vec_expr<E> && !std::same_as<expr_t<E>, Vec> && expr_t<E>::size == N) constexpr Vec(const E &e) { assign(e); }
+
+  constexpr Vec(const Vec &other)            = default;
+  constexpr Vec &operator=(const Vec &other) = default;
 
-  VEC_BASE_OPERATOR(+)
-  VEC_BASE_OPERATOR(-)
-  VEC_BASE_OPERATOR(*)
-  VEC_BASE_OPERATOR(/)
-#undef VEC_BASE_OPERATOR
+  template <typename E>
+  requires(vec_expr<E> && !std::same_as<expr_t<E>, Vec> && expr_t<E>::size == N) constexpr Vec &operator=(const E &e) {
+    assign(e);
+    return *this;
+  }
 
-#define VEC_OV_ASSIGNMENT(op)                \
-  template <typename U>                      \
-  Vec &operator op##=(const Vec<U, N> &vn) { \
-    return *this = *this op vn;              \
+  /* compound assignment beneran in place, elemen ke-i cuma baca elemen ke-i
+   * dari ekspresi jadi aman walau ekspresinya mengandung *this
+   */
+#define VEC_OV_ASSIGNMENT(op)                                                               \
+  template <typename E>                                                                     \
+  requires(vec_expr<E> && expr_t<E>::size == N) constexpr Vec &operator op##=(const E &e) { \
+    for (int i = 0; i < N; ++i) val[i] = val[i] op static_cast<T>(e.coeff(i));              \
+    return *this;                                                                           \
+  }                                                                                         \
+  template <typename S>                                                                     \
+  requires(scalar<S>) constexpr Vec &operator op##=(S s) {                                  \
+    for (int i = 0; i < N; ++i) val[i] = val[i] op static_cast<T>(s);                       \
+    return *this;                                                                           \
   }
 
   VEC_OV_ASSIGNMENT(+);
@@ -71,36 +92,44 @@ requires(std::integral<T> || std::floating_point<T>) class Vec {
 #undef VEC_OV_ASSIGNMENT
 
   // di dalam class Vec
-  auto w() const requires(N >= 4) { return val[3]; }
-
-  auto x() const requires(N >= 1) { return val[0]; }
-  auto y() const requires(N >= 2) { return val[1]; }
-  auto z() const requires(N >= 3) { return val[2]; }
-
-  T       &operator[](std::size_t i) { return val[i]; }
-  const T &operator[](std::size_t i) const { return val[i]; }
-  T       *data() { return val; }
+  constexpr auto w() const requires(N >= 4) { return val[3]; }
+
+  constexpr auto x() const requires(N >= 1) { return val[0]; }
+  constexpr auto y() const requires(N >= 2) { return val[1]; }
+  constexpr auto z() const requires(N >= 3) { return val[2]; }
+
+  constexpr T        coeff(int i) const { return val[i]; }
+  constexpr bool     reads_across(const void *) const { return false; }
+  constexpr T       &operator[](std::size_t i) { return val[i]; }
+  constexpr const T &operator[](std::size_t i) const { return val[i]; }
+  constexpr T       *data() { return val; }
+  constexpr const T *data() const { return val; }
 };
 
-template <typename T, int N>
-requires(std::floating_point<T>) Vec<T, N> normalize(Vec<T, N> target) {
-  T length = 0;
-  for (int i = 0; i < N; ++i) length += target[i] * target[i];
-  length = std::sqrt(length);
-  for (int i = 0; i < N; ++i) target[i] = target[i] / length;
+// normalize, dot dan cross menerima ekspresi juga, jadi normalize(a - b) tidak perlu Vec perantara
+template <typename E>
+requires(float_vec_expr<E>) constexpr auto normalize(const E &e) {
+  Vec<typename expr_t<E>::value_type, expr_t<E>::size> target(e);
+  typename expr_t<E>::value_type                        length = 0;
+  for (int i = 0; i < expr_t<E>::size; ++i) length += target[i] * target[i];
+  length = cx::sqrt(length);
+  for (int i = 0; i < expr_t<E>::size; ++i) target[i] = target[i] / length;
   return target;
 }
 
-template <typename T, int N>
-requires(std::floating_point<T>) T dot(const Vec<T, N> &a, const Vec<T, N> &b) {
-  T res = 0;
-  for (int i = 0; i < N; ++i) res += a[i] * b[i];
+template <typename A, typename B>
+requires(float_vec_expr<A> && vec_expr<B> && same_size<A, B>) constexpr auto dot(const A &a, const B &b) {
+  typename expr_t<A>::value_type res = 0;
+  for (int i = 0; i < expr_t<A>::size; ++i) res += a.coeff(i) * b.coeff(i);
   return res;
 }
 
-template <typename T>
-requires(std::floating_point<T>) Vec<T, 3> cross(const Vec<T, 3> &a, const Vec<T, 3> &b) {
-  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+template <typename A, typename B>
+requires(float_vec_expr<A> && vec_expr<B> && expr_t<A>::size == 3 && same_size<A, B>) constexpr auto cross(const A &a, const B &b) {
+  using T = typename expr_t<A>::value_type;
+  // evaluasi dulu karena tiap elemen dibaca dua kali
+  const Vec<T, 3> u(a), v(b);
+  return Vec<T, 3>{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
 }
 
 template <typename T>
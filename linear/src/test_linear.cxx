@@ -0,0 +1,275 @@
+/*
+  cpp-playground - C++ experiments and learning playground
+  Copyright (C) 2025 M. Reza Dwi Prasetiawan
+
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <dense_matrix.hxx>
+#include <factorization.hxx>
+#include <gemm.hxx>
+#include <iostream>
+#include <matrix.hxx>
+#include <random>
+#include <string>
+#include <transform.hxx>
+#include <vector>
+
+using namespace Linear;
+
+static int failed = 0;
+
+void check(const std::string &name, double err, double tol) {
+  std::cout << (err <= tol ? "[OK]   " : "[FAIL] ") << name << "\terr = " << err << std::endl;
+  if (err > tol) ++failed;
+}
+
+template <typename T>
+Matrix<T> random_matrix(std::size_t rows, std::size_t cols, std::mt19937 &gen) {
+  std::uniform_real_distribution<T> dis(-1, 1);
+  Matrix<T>                         m(rows, cols);
+  for (std::size_t i = 0; i < m.size(); ++i) m.data()[i] = dis(gen);
+  return m;
+}
+
+// referensi naive triple loop
+template <typename T>
+double max_err_vs_naive(MatrixView<const T> A, MatrixView<const T> B, MatrixView<const T> C, T alpha, T beta, const Matrix<T> &C0) {
+  double err = 0;
+  for (std::size_t i = 0; i < C.rows(); ++i)
+    for (std::size_t j = 0; j < C.cols(); ++j) {
+      double ref = 0;
+      for (std::size_t k = 0; k < A.cols(); ++k) ref += double(A(i, k)) * B(k, j);
+      ref = alpha * ref + beta * C0(i, j);
+      err = std::max(err, std::abs(ref - C(i, j)));
+    }
+  return err;
+}
+
+template <typename T>
+void test_gemm(std::mt19937 &gen, double tol) {
+  const std::string tname = sizeof(T) == 4 ? "float" : "double";
+  // ukuran ganjil supaya kena sisa MR/NR/KC
+  const std::size_t shapes[][3] = {{1, 1, 1}, {7, 5, 3}, {33, 17, 65}, {100, 300, 257}, {257, 129, 513}};
+  for (auto &s : shapes) {
+    Matrix<T> A = random_matrix<T>(s[0], s[2], gen), B = random_matrix<T>(s[2], s[1], gen), C = random_matrix<T>(s[0], s[1], gen), C0 = C;
+    gemm<T>(1.5, A, B, 0.5, C);
+    check("gemm<" + tname + "> " + std::to_string(s[0]) + "x" + std::to_string(s[1]) + "x" + std::to_string(s[2]),
+          max_err_vs_naive<T>(A, B, C, 1.5, 0.5, C0), tol);
+  }
+
+  // operand transpose (view col-major) tanpa copy
+  Matrix<T> At = random_matrix<T>(65, 40, gen), Bt = random_matrix<T>(70, 65, gen), C(40, 70), C0(40, 70);
+  gemm<T>(1, At.transposed(), Bt.transposed(), 0, C);
+  check("gemm<" + tname + "> A^T B^T", max_err_vs_naive<T>(At.transposed(), Bt.transposed(), C, 1, 0, C0), tol);
+
+  // gemv row-major dan col-major
+  Matrix<T>      A = random_matrix<T>(300, 200, gen);
+  std::vector<T> x(200), y(300), yt(200), xt(300);
+  for (auto &v : x) v = std::uniform_real_distribution<T>(-1, 1)(gen);
+  for (auto &v : xt) v = std::uniform_real_distribution<T>(-1, 1)(gen);
+  gemv<T>(1, A, x, 0, y);
+  gemv<T>(1, A.transposed(), xt, 0, yt);
+  double errRow = 0, errCol = 0;
+  for (std::size_t i = 0; i < 300; ++i) {
+    double ref = 0;
+    for (std::size_t j = 0; j < 200; ++j) ref += double(A(i, j)) * x[j];
+    errRow = std::max(errRow, std::abs(ref - y[i]));
+  }
+  for (std::size_t j = 0; j < 200; ++j) {
+    double ref = 0;
+    for (std::size_t i = 0; i < 300; ++i) ref += double(A(i, j)) * xt[i];
+    errCol = std::max(errCol, std::abs(ref - yt[j]));
+  }
+  check("gemv<" + tname + "> row-major", errRow, tol);
+  check("gemv<" + tname + "> col-major", errCol, tol);
+
+  // batched
+  std::vector<Matrix<T>>           As, Bs, Cs;
+  std::vector<MatrixView<const T>> Av, Bv;
+  std::vector<MatrixView<T>>       Cv;
+  for (int b = 0; b < 8; ++b) {
+    As.push_back(random_matrix<T>(20 + b, 30, gen));
+    Bs.push_back(random_matrix<T>(30, 10 + b, gen));
+    Cs.emplace_back(20 + b, 10 + b);
+  }
+  for (int b = 0; b < 8; ++b) {
+    Av.push_back(As[b].view());
+    Bv.push_back(Bs[b].view());
+    Cv.push_back(Cs[b].view());
+  }
+  gemm_batched<T>(1, Av, Bv, 0, Cv);
+  double errBatch = 0;
+  for (int b = 0; b < 8; ++b) errBatch = std::max(errBatch, max_err_vs_naive<T>(As[b], Bs[b], Cs[b], 1, 0, Cs[b]));
+  check("gemm_batched<" + tname + ">", errBatch, tol);
+}
+
+// bandingkan batch SoA dengan Mat * Vec per vertex, n sengaja bukan kelipatan LANES/CHUNK
+template <typename T>
+void test_transform(std::mt19937 &gen, double tol) {
+  const std::string                 tname = sizeof(T) == 4 ? "float" : "double";
+  std::uniform_real_distribution<T> dis(-10, 10);
+  const std::size_t                 n = 40000 + 13;
+
+  std::vector<Vec3<T>> pts(n);
+  for (auto &p : pts) p = Vec3<T>({dis(gen), dis(gen), dis(gen)});
+  Mat4<T> m;
+  for (int i = 0; i < 16; ++i) m.set_element(i, dis(gen));
+
+  PointsSoA<T>   in = aos_to_soa<T>(pts), out;
+  std::vector<T> w(n);
+  out.resize(n);
+  transform_points<T>(m, in.x, in.y, in.z, out.x, out.y, out.z, w);
+  double errH = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    Vec4<T> ref = m * Vec4<T>({pts[i][0], pts[i][1], pts[i][2], 1});
+    errH        = std::max({errH, double(std::abs(ref[0] - out.x[i])), double(std::abs(ref[1] - out.y[i])), double(std::abs(ref[2] - out.z[i])),
+                            double(std::abs(ref[3] - w[i]))});
+  }
+  check("transform_points<" + tname + "> homogeneous", errH, tol);
+
+  // affine in place lalu balik ke AoS
+  transform_points(m, in, in);
+  std::vector<Vec3<T>> back(n);
+  soa_to_aos<T>(in, back);
+  double errA = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    Vec4<T> ref = m * Vec4<T>({pts[i][0], pts[i][1], pts[i][2], 1});
+    for (int k = 0; k < 3; ++k) errA = std::max(errA, double(std::abs(ref[k] - back[i][k])));
+  }
+  check("transform_points<" + tname + "> affine in place", errA, tol);
+
+  Mat3<T> r = mat4_to_mat3(m);
+  in        = aos_to_soa<T>(pts);
+  transform_points(r, in, out);
+  double errR = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    Vec3<T> ref = r * pts[i];
+    errR        = std::max({errR, double(std::abs(ref[0] - out.x[i])), double(std::abs(ref[1] - out.y[i])), double(std::abs(ref[2] - out.z[i]))});
+  }
+  check("transform_points<" + tname + "> mat3", errR, tol);
+}
+
+// matriks proyeksi/kamera dengan parameter konstan dilipat saat compile
+constexpr Mat4d ORTHO     = ORTHOGRAPHIC_MATRIX<double>(-2, 2, 1, -1, 0.5, 10);
+constexpr Mat4d ORTHO_INV = ORTHO.inverse();
+static_assert(ORTHO_INV(0, 0) == 2 && ORTHO.determinant() != 0);
+constexpr Mat4d CAM = VIEW_MATRIX<double>({1, 2, 3}, {0, 0, 0});
+static_assert(Mat4d(CAM * CAM.inverse())(3, 3) > 0.999);
+
+// M * M⁻¹ - I, dinormalisasi dengan |1/det| supaya matriks hampir singular tidak bikin gagal palsu
+template <int N>
+double inverse_err(const Mat<double, N> &m, const Mat<double, N> &inv) {
+  Mat<double, N> p   = m * inv;
+  double         err = 0;
+  for (int i = 0; i < N; ++i)
+    for (int j = 0; j < N; ++j) err = std::max(err, std::abs(p(i, j) - (i == j)));
+  return err;
+}
+
+template <int N>
+void test_small_inverse(std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dis(-1, 1);
+  double                                 err = 0;
+  for (int t = 0; t < 1000; ++t) {
+    Mat<double, N> m;
+    for (int i = 0; i < N * N; ++i) m.set_element(i, dis(gen));
+    err = std::max(err, inverse_err<N>(m, m.inverse()) / (1 + std::abs(1 / m.determinant())));
+  }
+  check("Mat<double, " + std::to_string(N) + ">::inverse", err, 1e-12);
+}
+
+void test_affine_inverse() {
+  Mat4d rigid = mat3_to_mat4(QUATERNION_MATRIX<double>({0, 0, 1}, 0.7));
+  rigid.set_element(3, 1);
+  rigid.set_element(7, 2);
+  rigid.set_element(11, -3);
+  Mat4d affine = rigid * mat3_to_mat4(Mat3d{2, 0, 0, 0, 0.5, 0, 0, 0, 3});
+  check("Mat4::rigid_inverse", inverse_err<4>(rigid, rigid.rigid_inverse()), 1e-12);
+  check("Mat4::affine_inverse", inverse_err<4>(affine, affine.affine_inverse()), 1e-12);
+  check("Mat4::inverse view matrix", inverse_err<4>(CAM, CAM.inverse()), 1e-12);
+}
+
+// max |A X - B| untuk cek hasil solve
+template <typename T>
+double residual(const Matrix<T> &A, const Matrix<T> &X, const Matrix<T> &B) {
+  Matrix<T> R = B;
+  gemm<T>(1, A, X, -1, R);
+  double err = 0;
+  for (std::size_t i = 0; i < R.size(); ++i) err = std::max(err, double(std::abs(R.data()[i])));
+  return err;
+}
+
+template <typename T>
+void test_factorization(std::mt19937 &gen, double tol) {
+  const std::string tname = sizeof(T) == 4 ? "float" : "double";
+  // n bukan kelipatan NB supaya blok terakhir tidak penuh
+  for (std::size_t n : {5, 64, 200, 333}) {
+    Matrix<T> A = random_matrix<T>(n, n, gen), B = random_matrix<T>(n, 7, gen);
+    // diagonal diperbesar sedikit biar kondisinya wajar, pivoting tetap kepakai
+    for (std::size_t i = 0; i < n; ++i) A(i, i) += T(2);
+    LU<T> lu(A);
+    check("LU<" + tname + "> n=" + std::to_string(n) + " multi rhs", residual<T>(A, lu.solve(B), B), tol * n);
+
+    std::vector<T> b(n), x;
+    for (auto &v : b) v = std::uniform_real_distribution<T>(-1, 1)(gen);
+    x = lu.solve(std::span<const T>(b));
+    Matrix<T> Xv(n, 1), Bv(n, 1);
+    for (std::size_t i = 0; i < n; ++i) Xv(i, 0) = x[i], Bv(i, 0) = b[i];
+    check("LU<" + tname + "> n=" + std::to_string(n) + " single rhs", residual<T>(A, Xv, Bv), tol * n);
+
+    // SPD: M Mᵀ + n I
+    Matrix<T> S(n, n);
+    gemm<T>(1, A, A.transposed(), 0, S);
+    for (std::size_t i = 0; i < n; ++i) S(i, i) += T(n);
+    Cholesky<T> ch(S);
+    check("Cholesky<" + tname + "> n=" + std::to_string(n), residual<T>(S, ch.solve(B), B) / n, tol);
+  }
+
+  // determinan LU vs rumus tutup Mat4
+  Mat4d m;
+  for (int i = 0; i < 16; ++i) m.set_element(i, std::uniform_real_distribution<double>(-1, 1)(gen));
+  Matrix<double> M(4, 4);
+  for (int i = 0; i < 16; ++i) M.data()[i] = m.coeff(i);
+  check("LU<double>::determinant", std::abs(LU<double>(M).determinant() - m.determinant()), 1e-12);
+}
+
+int main() {
+  std::mt19937 gen(42);
+  test_gemm<float>(gen, 1e-3);
+  test_gemm<double>(gen, 1e-10);
+  test_transform<float>(gen, 1e-3);
+  test_transform<double>(gen, 1e-10);
+  test_small_inverse<2>(gen);
+  test_small_inverse<3>(gen);
+  test_small_inverse<4>(gen);
+  test_small_inverse<5>(gen);
+  test_affine_inverse();
+  test_factorization<float>(gen, 1e-4);
+  test_factorization<double>(gen, 1e-12);
+
+  // sekedar info throughput, bukan bagian dari pass/fail
+  const std::size_t n = 1024;
+  Matrix<float>     A = random_matrix<float>(n, n, gen), B = random_matrix<float>(n, n, gen), C(n, n);
+  auto              start = std::chrono::steady_clock::now();
+  gemm<float>(1, A, B, 0, C);
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "sgemm " << n << "^3 : " << sec * 1e3 << " ms, " << 2.0 * n * n * n / sec * 1e-9 << " GFLOPS" << std::endl;
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
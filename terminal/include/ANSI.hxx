@@ -19,7 +19,9 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstdlib>
 #include <string>
 
 #ifdef _WIN32
@@ -34,6 +36,25 @@ class ANSI {
 
   void appendByte(uint8_t n) { writeByte(buf_, n); }
 
+  static uint8_t nearest256(int r, int g, int b) {
+    constexpr int level[6] = {0, 95, 135, 175, 215, 255};
+    auto cube = [&](int v) {
+      int best = 0;
+      for (int k = 1; k < 6; ++k)
+        if (std::abs(level[k] - v) < std::abs(level[best] - v)) best = k;
+      return best;
+    };
+    auto dist = [&](int cr, int cg, int cb) { return (cr - r) * (cr - r) + (cg - g) * (cg - g) + (cb - b) * (cb - b); };
+
+    const int cr = cube(r), cg = cube(g), cb = cube(b);
+    const int dc = dist(level[cr], level[cg], level[cb]);
+    /* Abu-abu 232..255 = 8 + 10k, ambil yang terdekat dengan rata-rata */
+    const int k  = std::clamp(((r + g + b) / 3 - 8 + 5) / 10, 0, 23);
+    const int gv = 8 + 10 * k;
+    if (dist(gv, gv, gv) < dc) return static_cast<uint8_t>(232 + k);
+    return static_cast<uint8_t>(16 + 36 * cr + 6 * cg + cb);
+  }
+
  public:
   /* ── Static write helpers — thread-safe, tulis ke string eksternal ────────
    * Karena parameternya std::string& milik caller (bukan buf_), fungsi ini
@@ -65,16 +86,48 @@ class ANSI {
     writeByte(s, b); s += 'm';
   }
 
- private:
+  /* Palet xterm 256: "\033[48;5;Nm" maksimal 11 byte, truecolor sampai 19 */
+  static void writeBg256(std::string& s, uint8_t idx) {
+    s += "\033[48;5;"; writeByte(s, idx); s += 'm';
+  }
 
-  /* Untuk angka umum (baris/kolom) — tidak di hot path */
-  void appendInt(int n) {
-    if (n == 0) { buf_ += '0'; return; }
+  static void writeFg256(std::string& s, uint8_t idx) {
+    s += "\033[38;5;"; writeByte(s, idx); s += 'm';
+  }
+
+  /* RGB → indeks palet 256 terdekat (kubus 6×6×6 di 16..231 atau abu-abu 232..255;
+   * 16 warna sistem dilewati karena nilainya tergantung tema terminal).
+   * LUT 32×32×32 (5 bit per kanal, 32 KiB) dibangun sekali saat pertama dipakai. */
+  static uint8_t rgbTo256(uint8_t r, uint8_t g, uint8_t b) {
+    static const auto lut = [] {
+      std::array<uint8_t, 32 * 32 * 32> t{};
+      for (int i = 0; i < 32 * 32 * 32; ++i) {
+        /* Wakil tiap sel LUT = tengah rentang 8 nilai */
+        const int r8 = ((i >> 10) << 3) | 4, g8 = (((i >> 5) & 31) << 3) | 4, b8 = ((i & 31) << 3) | 4;
+        t[static_cast<size_t>(i)] = nearest256(r8, g8, b8);
+      }
+      return t;
+    }();
+    return lut[static_cast<size_t>((r >> 3) << 10 | (g >> 3) << 5 | (b >> 3))];
+  }
+
+  static void writeInt(std::string& s, int n) {
+    if (n == 0) { s += '0'; return; }
     char tmp[12]; int i = 12;
     while (n > 0) { tmp[--i] = static_cast<char>('0' + n % 10); n /= 10; }
-    buf_.append(tmp + i, static_cast<std::size_t>(12 - i));
+    s.append(tmp + i, static_cast<std::size_t>(12 - i));
+  }
+
+  /* Posisi cursor 1-based, dipakai render diff untuk lompat ke awal run */
+  static void writeMoveCursor(std::string& s, int row, int col) {
+    s += "\033["; writeInt(s, row); s += ';'; writeInt(s, col); s += 'H';
   }
 
+ private:
+
+  /* Untuk angka umum (baris/kolom) — tidak di hot path */
+  void appendInt(int n) { writeInt(buf_, n); }
+
   ANSI() {
 #ifdef _WIN32
     HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -109,6 +162,7 @@ class ANSI {
   void append(std::string_view sv) { buf_.append(sv.data(), sv.size()); }
   void append(char c)              { buf_ += c; }
   void reserve(std::size_t n)      { buf_.reserve(n); }
+  std::size_t size() const         { return buf_.size(); }
 
   // ── Screen ────────────────────────────────────────────────────────────────
   void enterAlternateScreen() { buf_ += "\033[?1049h"; flush(); }
@@ -120,9 +174,7 @@ class ANSI {
   void scrollDown(int n = 1)  { buf_ += "\033["; appendInt(n); buf_ += 'T'; }
 
   // ── Cursor ────────────────────────────────────────────────────────────────
-  void moveCursor(int row, int col) {
-    buf_ += "\033["; appendInt(row); buf_ += ';'; appendInt(col); buf_ += 'H';
-  }
+  void moveCursor(int row, int col) { writeMoveCursor(buf_, row, col); }
   void cursorUp(int n = 1)      { buf_ += "\033["; appendInt(n); buf_ += 'A'; }
   void cursorDown(int n = 1)    { buf_ += "\033["; appendInt(n); buf_ += 'B'; }
   void cursorForward(int n = 1) { buf_ += "\033["; appendInt(n); buf_ += 'C'; }
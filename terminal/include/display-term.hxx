@@ -18,11 +18,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <mutex>
+#include <span>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -37,15 +42,133 @@
 #endif
 
 class Display {
+ public:
   using RGB = std::array<uint8_t, 3>;
 
+  /* Sel berisi HALF_BLOCK digambar sebagai '▀' (U+2580): foreground = piksel
+   * atas, background = piksel bawah — dua piksel vertikal per sel.          */
+  static constexpr char HALF_BLOCK = '\x01';
+
+  /* TRUECOLOR: escape 24 bit apa adanya. PALETTE_256: warna dikuantisasi ke
+   * palet xterm 256 lewat LUT, escape lebih pendek dan warna yang mirip
+   * dianggap sama sehingga lebih sedikit sel/escape yang dikirim.        */
+  enum class COLOR_MODE { TRUECOLOR, PALETTE_256 };
+
+  /* View 2D di atas plane datar width×height — tidak memiliki memori, cuma
+   * pointer + stride. row(y) memberi span satu baris, (y, x) satu sel.     */
+  template <typename T>
+  struct Plane {
+    T*     ptr    = nullptr;
+    int    width  = 0;
+    int    height = 0;
+    size_t stride = 0;
+
+    std::span<T> row(int y) const { return {ptr + static_cast<size_t>(y) * stride, static_cast<size_t>(width)}; }
+    T&           operator()(int y, int x) const { return ptr[static_cast<size_t>(y) * stride + static_cast<size_t>(x)]; }
+  };
+
+  /* Akses tulis ke frame selama objek ini hidup — mutex dipegang sampai
+   * destructor, jadi render()/present() tidak bisa memakai frame setengah jadi.
+   * View invalid setelah Frame dilepas (resize/present bisa ganti buffer).    */
+  struct Frame {
+    std::unique_lock<std::mutex> lock;
+    Plane<char>                  chars;
+    Plane<RGB>                   background, foreground;
+  };
+
+  /* Statistik present: published = frame yang diserahkan producer,
+   * presented = yang benar-benar ditulis ke terminal, dropped = yang
+   * tertimpa frame lebih baru sebelum sempat digambar (mode async).  */
+  struct PresentStats {
+    uint64_t published = 0, presented = 0, dropped = 0;
+    double   lastMs = 0, avgMs = 0;
+    size_t   lastBytes = 0;
+  };
+
  private:
-  int                        width, height;
-  inline static std::mutex   data_mtx;
-  inline static ANSI&        ansiInstance = ANSI::getInstance();
-  std::vector<std::vector<RGB>>  backgroundRGB, foregroundRGB;
-  std::vector<std::vector<char>> data;
-  std::thread                    runner;
+  /* Satu frame lengkap: plane datar row-major, stride = width — satu alokasi
+   * per plane, bukan per baris. Ukuran ikut disimpan karena di mode async
+   * tiap buffer bisa tertinggal satu resize dari yang lain.                 */
+  struct Buffer {
+    int               width = 0, height = 0;
+    std::vector<char> data;
+    std::vector<RGB>  backgroundRGB, foregroundRGB;
+
+    size_t cells() const { return static_cast<size_t>(width) * static_cast<size_t>(height); }
+
+    /* assign() memakai ulang kapasitas lama — resize ke ukuran yang pernah
+     * dicapai tidak alokasi lagi.                                          */
+    void reset(int w, int h) {
+      width  = w;
+      height = h;
+      data.assign(cells(), ' ');
+      backgroundRGB.assign(cells(), {0, 0, 0});
+      foregroundRGB.assign(cells(), {255, 255, 255});
+    }
+
+    void copy_from(const Buffer& o) {
+      width         = o.width;
+      height        = o.height;
+      data          = o.data;
+      backgroundRGB = o.backgroundRGB;
+      foregroundRGB = o.foregroundRGB;
+    }
+  };
+
+  int                      width, height;
+  inline static std::mutex data_mtx;
+  inline static ANSI&      ansiInstance = ANSI::getInstance();
+
+  /* Triple buffer: buffers[back] milik producer (dijaga data_mtx), buffers[front]
+   * milik render thread, slot tengah berpindah tangan lewat exchange atomik.
+   * Nilai middle = indeks | FRESH (belum digambar) | WAKE (bangunkan untuk stop).
+   * Mode sync cuma memakai buffers[back].                                      */
+  static constexpr uint8_t IDX = 3, FRESH = 4, WAKE = 8;
+  std::array<Buffer, 3>    buffers;
+  int                      back = 0, front = 2;
+  std::atomic<uint8_t>     middle{1};
+  std::atomic<bool>        asyncRunning{false};
+  std::chrono::nanoseconds minInterval{0};
+  std::thread              runner;
+
+  /* Frame yang terakhir benar-benar dikirim ke terminal — emit() cuma mengirim
+   * sel yang berbeda dari sini. Hanya disentuh oleh pihak yang menggambar
+   * (pemanggil render() di mode sync, runner di mode async).                */
+  Buffer                   prev;
+  std::atomic<bool>        fullRedraw{true};
+  std::atomic<COLOR_MODE>  colorMode{COLOR_MODE::TRUECOLOR};
+  /* Satu string per baris, dipakai ulang antar frame — clear() tidak membuang kapasitas */
+  std::vector<std::string> rowBufs;
+
+  std::atomic<uint64_t> statPublished{0}, statPresented{0}, statDropped{0}, statTotalNs{0}, statLastNs{0};
+  std::atomic<size_t>   lastFrameBytes{0};
+
+  /* Celah sel tak berubah di antara dua run yang masih lebih murah dikirim ulang
+   * daripada escape posisi cursor baru ("\033[rrr;cccH" ~ 8-10 byte).          */
+  static constexpr int RUN_GAP = 8;
+
+  Buffer& cur() { return buffers[static_cast<size_t>(back)]; }
+
+  template <typename T>
+  Plane<T> plane(std::vector<T>& v) {
+    return {v.data(), cur().width, cur().height, static_cast<size_t>(cur().width)};
+  }
+
+  /* Salin blok RGB8 terpacked (srcStride dalam byte) ke plane pada (dstX, dstY),
+   * dipotong di tepi layar. Baris paralel, tiap baris satu memcpy.            */
+  void blit(std::vector<RGB>& dst, const uint8_t* src, int srcW, int srcH, size_t srcStride, int dstX, int dstY) {
+    const int w  = cur().width;
+    const int x0 = std::max(dstX, 0), x1 = std::min(dstX + srcW, w);
+    const int y0 = std::max(dstY, 0), y1 = std::min(dstY + srcH, cur().height);
+    if (x0 >= x1 || y0 >= y1) return;
+    static_assert(sizeof(RGB) == 3, "RGB harus terpacked 3 byte");
+    const size_t n = static_cast<size_t>(x1 - x0) * sizeof(RGB);
+#pragma omp parallel for schedule(static)
+    for (int y = y0; y < y1; ++y) {
+      const uint8_t* s = src + static_cast<size_t>(y - dstY) * srcStride + static_cast<size_t>(x0 - dstX) * 3;
+      std::memcpy(&dst[static_cast<size_t>(y) * static_cast<size_t>(w) + static_cast<size_t>(x0)], s, n);
+    }
+  }
 
 #ifndef _WIN32
   inline static std::atomic<bool> resize_pending{false};
@@ -54,6 +177,8 @@ class Display {
     resize_pending.store(true, std::memory_order_relaxed);
   }
 
+  /* Dipanggil dengan data_mtx terkunci, dari sisi producer. Cukup ganti ukuran
+   * back buffer — layar dibersihkan oleh emit() saat melihat ukuran baru.    */
   void handle_resize() {
     if (!resize_pending.load(std::memory_order_relaxed)) return;
     resize_pending.store(false, std::memory_order_relaxed);
@@ -61,19 +186,151 @@ class Display {
     struct winsize w;
     if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) != 0) return;
 
-    using namespace std;
-    lock_guard<mutex> lock(data_mtx);
     width  = w.ws_col;
     height = w.ws_row;
-    data.assign(height, vector<char>(width, ' '));
-    backgroundRGB.assign(height, vector<RGB>(width, {0, 0, 0}));
-    foregroundRGB.assign(height, vector<RGB>(width, {255, 255, 255}));
-    /* Force full redraw setelah resize */
-    ansiInstance.clearScreen();
-    ansiInstance.flush();
+    cur().reset(width, height);
   }
 #endif
 
+  /* Tulis frame f ke terminal: per baris hanya run sel yang berbeda dari prev. */
+  void emit(const Buffer& f) {
+    using namespace std;
+    const auto t0 = chrono::steady_clock::now();
+
+    /* Ukuran berubah (resize): isi layar tidak diketahui lagi, gambar ulang penuh */
+    if (f.width != prev.width || f.height != prev.height) {
+      prev.reset(f.width, f.height);
+      ansiInstance.clearScreen();
+      fullRedraw = true;
+    }
+
+    const int  rows = f.height;
+    const int  cols = f.width;
+    const bool full = fullRedraw.exchange(false);
+    const bool pal  = colorMode.load(memory_order_relaxed) == COLOR_MODE::PALETTE_256;
+
+    /* Tiap thread OMP tulis ke string baris miliknya sendiri, tidak ada
+     * sharing sehingga tidak perlu mutex di dalam loop paralel.
+     * Baris yang tidak berubah tetap string kosong.                   */
+    rowBufs.resize(static_cast<size_t>(rows));
+
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < rows; ++y) {
+      const size_t off = static_cast<size_t>(y) * static_cast<size_t>(cols);
+      const char*  d   = f.data.data() + off;
+      const RGB*   bg  = f.backgroundRGB.data() + off;
+      const RGB*   fg  = f.foregroundRGB.data() + off;
+      char*        pd  = prev.data.data() + off;
+      RGB*         pb  = prev.backgroundRGB.data() + off;
+      RGB*         pf  = prev.foregroundRGB.data() + off;
+
+      /* Di mode palet dua warna dianggap sama kalau indeks paletnya sama */
+      auto same    = [&](const RGB& a, const RGB& b) {
+        return pal ? ANSI::rgbTo256(a[0], a[1], a[2]) == ANSI::rgbTo256(b[0], b[1], b[2]) : a == b;
+      };
+      auto changed = [&](int x) { return full || d[x] != pd[x] || !same(bg[x], pb[x]) || !same(fg[x], pf[x]); };
+
+      string& s = rowBufs[static_cast<size_t>(y)];
+      s.clear();
+
+      /* Sentinel 256 = belum ada warna — paksa emit pada sel pertama tiap baris.
+       * Di antara run dalam satu baris warna terminal tetap diketahui.         */
+      constexpr uint16_t NONE = 256;
+      uint16_t cur_br = NONE, cur_bg_ = NONE, cur_bb = NONE;
+      uint16_t cur_fr = NONE, cur_fg_ = NONE, cur_fb = NONE;
+
+      int x = 0;
+      while (x < cols) {
+        if (!changed(x)) { ++x; continue; }
+
+        /* Cari ujung run: gabungkan run berikutnya kalau celahnya < RUN_GAP */
+        const int x0  = x;
+        int       end = x + 1;
+        for (x = end; x < cols && x - end < RUN_GAP; ++x)
+          if (changed(x)) end = x + 1;
+        x = end;
+
+        ANSI::writeMoveCursor(s, y + 1, x0 + 1);
+        for (int i = x0; i < end; ++i) {
+          const auto& b = bg[i];
+          const auto& c = fg[i];
+
+          if (pal) {
+            /* Mode palet cukup lacak indeks, disimpan di cur_br / cur_fr */
+            const uint8_t bi = ANSI::rgbTo256(b[0], b[1], b[2]);
+            const uint8_t fi = ANSI::rgbTo256(c[0], c[1], c[2]);
+            if (bi != cur_br) { ANSI::writeBg256(s, bi); cur_br = bi; }
+            if (fi != cur_fr) { ANSI::writeFg256(s, fi); cur_fr = fi; }
+          } else {
+            if (b[0] != cur_br || b[1] != cur_bg_ || b[2] != cur_bb) {
+              ANSI::writeBgRGB(s, b[0], b[1], b[2]);
+              cur_br = b[0]; cur_bg_ = b[1]; cur_bb = b[2];
+            }
+
+            if (c[0] != cur_fr || c[1] != cur_fg_ || c[2] != cur_fb) {
+              ANSI::writeFgRGB(s, c[0], c[1], c[2]);
+              cur_fr = c[0]; cur_fg_ = c[1]; cur_fb = c[2];
+            }
+          }
+
+          if (d[i] == HALF_BLOCK) s += "\xE2\x96\x80"; /* '▀' dalam UTF-8 */
+          else s += d[i];
+        }
+
+        /* Simpan hanya bagian yang dikirim — sisa baris memang sudah sama */
+        copy(d + x0, d + end, pd + x0);
+        copy(bg + x0, bg + end, pb + x0);
+        copy(fg + x0, fg + end, pf + x0);
+      }
+    }
+
+    /* Hitung total size dengan reduction — lalu gabung serial (urutan harus terjaga) */
+    size_t total = 0;
+#pragma omp parallel for schedule(static) reduction(+ : total)
+    for (int y = 0; y < rows; ++y) total += rowBufs[static_cast<size_t>(y)].size();
+
+    /* Frame identik: tidak ada yang perlu ditulis, hemat syscall juga */
+    size_t bytes = 0;
+    if (total != 0) {
+      ansiInstance.reserve(total + 16); /* +16 untuk reset */
+      for (auto& s : rowBufs) ansiInstance.append(s);
+      ansiInstance.reset();
+      bytes = ansiInstance.size();
+      ansiInstance.flush();
+    } else if (ansiInstance.size() != 0) {
+      ansiInstance.flush(); /* sisa clearScreen setelah resize */
+    }
+
+    const uint64_t ns = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count());
+    lastFrameBytes.store(bytes, memory_order_relaxed);
+    statLastNs.store(ns, memory_order_relaxed);
+    statTotalNs.fetch_add(ns, memory_order_relaxed);
+    statPresented.fetch_add(1, memory_order_relaxed);
+  }
+
+  /* Loop render thread: tunggu frame FRESH di slot tengah, tukar dengan front,
+   * gambar. Frame yang datang lebih cepat dari minInterval saling menimpa di
+   * slot tengah, jadi yang digambar selalu frame lengkap terbaru.            */
+  void render_loop() {
+    using namespace std;
+    auto next = chrono::steady_clock::now();
+    while (true) {
+      uint8_t v = middle.load(memory_order_acquire);
+      if (!asyncRunning.load()) break;
+      if (!(v & FRESH)) {
+        middle.wait(v, memory_order_acquire);
+        continue;
+      }
+      if (minInterval.count() > 0) {
+        this_thread::sleep_until(next);
+        next = chrono::steady_clock::now() + minInterval;
+      }
+      v     = middle.exchange(static_cast<uint8_t>(front), memory_order_acq_rel);
+      front = v & IDX;
+      emit(buffers[static_cast<size_t>(front)]);
+    }
+  }
+
   Display() {
 #ifndef _WIN32
     struct winsize w;
@@ -99,9 +356,8 @@ class Display {
       height = 24;
     }
 #endif
-    data.resize(height, std::vector<char>(width, ' '));
-    backgroundRGB.resize(height, std::vector<RGB>(width, {0, 0, 0}));
-    foregroundRGB.resize(height, std::vector<RGB>(width, {255, 255, 255}));
+    for (auto& b : buffers) b.reset(width, height);
+    prev.reset(width, height);
     ansiInstance.enterAlternateScreen();
     /* Sembunyikan cursor sekali saja — tidak perlu tiap frame */
     ansiInstance.hideCursor();
@@ -118,132 +374,186 @@ class Display {
   }
 
   ~Display() {
+    stop_async();
     ansiInstance.reset();
     ansiInstance.exitAlternateScreen();
     ansiInstance.showCursor();
     ansiInstance.flush();
   }
 
-  int   get_width() const { return width; }
-  int   get_height() const { return height; }
-  ANSI& getANSI() { return ansiInstance; }
+  int    get_width() const { return width; }
+  int    get_height() const { return height; }
+  ANSI&  getANSI() { return ansiInstance; }
+  /* Jumlah byte yang dikirim frame terakhir, 0 kalau frame tidak berubah */
+  size_t last_frame_bytes() const { return lastFrameBytes.load(std::memory_order_relaxed); }
 
-  std::vector<std::vector<RGB>> get_background_RGB() {
+  PresentStats present_stats() const {
     using namespace std;
-    lock_guard<mutex> lock(data_mtx);
-    return backgroundRGB;
+    PresentStats st;
+    st.published = statPublished.load(memory_order_relaxed);
+    st.presented = statPresented.load(memory_order_relaxed);
+    st.dropped   = statDropped.load(memory_order_relaxed);
+    st.lastMs    = statLastNs.load(memory_order_relaxed) * 1e-6;
+    st.avgMs     = st.presented ? statTotalNs.load(memory_order_relaxed) * 1e-6 / static_cast<double>(st.presented) : 0.0;
+    st.lastBytes = last_frame_bytes();
+    return st;
   }
 
-  std::vector<std::vector<RGB>> get_foreground_RGB() {
+  /* Paksa frame berikutnya digambar ulang penuh, mis. setelah program lain menulis ke terminal */
+  void force_redraw() { fullRedraw = true; }
+
+  /* Ganti mode warna; frame berikutnya digambar ulang penuh dengan mode baru */
+  void set_color_mode(COLOR_MODE m) {
+    colorMode  = m;
+    fullRedraw = true;
+  }
+  COLOR_MODE get_color_mode() const { return colorMode.load(std::memory_order_relaxed); }
+
+  /* Resolusi piksel mode half-block: lebar sama, tinggi dua kali jumlah baris */
+  int get_pixel_height() const { return height * 2; }
+
+  /* Mode async: render thread terpisah menggambar frame yang diserahkan lewat
+   * present(), producer tidak pernah menunggu write(2). maxFps > 0 membatasi
+   * laju tulis ke terminal; frame berlebih dibuang, bukan diantrekan.        */
+  void start_async(double maxFps = 0) {
+    if (asyncRunning.exchange(true)) return;
+    minInterval = maxFps > 0 ? std::chrono::nanoseconds(static_cast<int64_t>(1e9 / maxFps)) : std::chrono::nanoseconds(0);
+    runner      = std::thread(&Display::render_loop, this);
+  }
+
+  /* Hentikan render thread; frame yang belum sempat digambar dibuang */
+  void stop_async() {
+    if (!asyncRunning.exchange(false)) return;
+    middle.fetch_or(WAKE, std::memory_order_release);
+    middle.notify_one();
+    if (runner.joinable()) runner.join();
+  }
+
+  bool is_async() const { return asyncRunning.load(std::memory_order_relaxed); }
+
+  /* Serahkan back buffer. Mode sync sama dengan render(). Mode async: tukar
+   * back dengan slot tengah (lock-free terhadap render thread) lalu bangunkan
+   * runner. preserve = true menyalin frame barusan ke back buffer baru supaya
+   * producer yang menggambar inkremental (hapus-lalu-tulis) tetap benar;
+   * producer yang menimpa seluruh frame bisa pakai false dan hemat memcpy.   */
+  void present(bool preserve = true) {
+    if (!is_async()) {
+      render();
+      return;
+    }
+
     using namespace std;
     lock_guard<mutex> lock(data_mtx);
-    return foregroundRGB;
+    statPublished.fetch_add(1, memory_order_relaxed);
+
+    const int     pub = back;
+    const uint8_t old = middle.exchange(static_cast<uint8_t>(pub | FRESH), memory_order_acq_rel);
+    if (old & FRESH) statDropped.fetch_add(1, memory_order_relaxed);
+    back = old & IDX;
+    middle.notify_one();
+
+    /* Frame yang baru diterbitkan hanya dibaca dari sini dan oleh runner, aman disalin */
+    if (preserve)
+      cur().copy_from(buffers[static_cast<size_t>(pub)]);
+#ifndef _WIN32
+    handle_resize();
+#endif
+    if (cur().width != width || cur().height != height) cur().reset(width, height);
   }
 
-#define setter_RGB(name)                                                                                  \
-  void set_##name(int r, int g, int b) {                                                                  \
-    uint8_t ur = static_cast<uint8_t>(r), ug = static_cast<uint8_t>(g), ub = static_cast<uint8_t>(b);   \
-    using namespace std;                                                                                   \
-    lock_guard<mutex> lock(data_mtx);                                                                     \
-    _Pragma("omp parallel for") for (auto& row : name##RGB) for (auto& px : row) px = {ur, ug, ub};      \
+  /* Kunci frame dan kembalikan view ke ketiga plane, tanpa salinan.
+   * Ukuran dibaca dari view (chars.width/height), bukan get_width(),
+   * supaya konsisten dengan plane yang sedang dikunci.              */
+  Frame lock_frame() {
+    std::unique_lock<std::mutex> lock(data_mtx);
+    return {std::move(lock), plane(cur().data), plane(cur().backgroundRGB), plane(cur().foregroundRGB)};
+  }
+
+#define setter_RGB(name)                                                                                 \
+  void set_##name(int r, int g, int b) {                                                                 \
+    const RGB c{static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b)};             \
+    using namespace std;                                                                                 \
+    lock_guard<mutex> lock(data_mtx);                                                                    \
+    fill(cur().name##RGB.begin(), cur().name##RGB.end(), c);                                             \
   }
 
   setter_RGB(background);
   setter_RGB(foreground);
 #undef setter_RGB
 
-  bool push_buffer(int row, const std::vector<char>& buffer) {
-    using namespace std;
-    lock_guard<mutex> lock(data_mtx);
-#pragma omp parallel for
-    for (size_t i = 0; i < buffer.size(); ++i) data[row][i] = buffer[i];
-    return true;
+  /* Blit RGB8 terpacked (r,g,b per piksel, srcStride byte per baris, 0 = srcW·3)
+   * ke plane warna — cocok langsung dengan cv::Mat RGB atau buffer PNG.        */
+#define blit_RGB(name)                                                                                                  \
+  void blit_##name(const uint8_t* rgb8, int srcW, int srcH, size_t srcStride = 0, int dstX = 0, int dstY = 0) {        \
+    using namespace std;                                                                                                \
+    lock_guard<mutex> lock(data_mtx);                                                                                   \
+    blit(cur().name##RGB, rgb8, srcW, srcH, srcStride ? srcStride : static_cast<size_t>(srcW) * 3, dstX, dstY);         \
   }
 
-  bool push_buffer(int row, std::initializer_list<char> buffer) {
+  blit_RGB(background);
+  blit_RGB(foreground);
+#undef blit_RGB
+
+  /* Blit RGB8 terpacked ke grid piksel half-block (koordinat piksel, tinggi
+   * 2 × baris): tiap sel yang tersentuh jadi HALF_BLOCK dengan fg = piksel
+   * atas, bg = piksel bawah. Kalau cuma separuh sel yang kena (tepi ganjil),
+   * separuh lainnya mempertahankan warna yang sedang tampil di sana.        */
+  void blit_pixels(const uint8_t* rgb8, int srcW, int srcH, size_t srcStride = 0, int dstX = 0, int dstY = 0) {
     using namespace std;
     lock_guard<mutex> lock(data_mtx);
-    size_t i = 0;
-    for (auto c : buffer) data[row][i++] = c;
-    return true;
+    Buffer&      b      = cur();
+    const size_t stride = srcStride ? srcStride : static_cast<size_t>(srcW) * 3;
+    const int    w      = b.width;
+    const int    x0 = max(dstX, 0), x1 = min(dstX + srcW, w);
+    const int    y0 = max(dstY, 0), y1 = min(dstY + srcH, b.height * 2);
+    if (x0 >= x1 || y0 >= y1) return;
+
+#pragma omp parallel for schedule(static)
+    for (int cy = y0 / 2; cy < (y1 + 1) / 2; ++cy) {
+      const int      top = 2 * cy, bot = top + 1;
+      const uint8_t* ts  = (top >= y0 && top < y1) ? rgb8 + static_cast<size_t>(top - dstY) * stride : nullptr;
+      const uint8_t* bs  = (bot >= y0 && bot < y1) ? rgb8 + static_cast<size_t>(bot - dstY) * stride : nullptr;
+      const size_t   off = static_cast<size_t>(cy) * static_cast<size_t>(w);
+      for (int x = x0; x < x1; ++x) {
+        const size_t i  = off + static_cast<size_t>(x);
+        const size_t sx = static_cast<size_t>(x - dstX) * 3;
+        /* Warna atas yang sedang tampil: fg kalau sudah half-block, selain itu bg */
+        const RGB    oldTop = b.data[i] == HALF_BLOCK ? b.foregroundRGB[i] : b.backgroundRGB[i];
+        b.foregroundRGB[i]  = ts ? RGB{ts[sx], ts[sx + 1], ts[sx + 2]} : oldTop;
+        if (bs) b.backgroundRGB[i] = {bs[sx], bs[sx + 1], bs[sx + 2]};
+        b.data[i] = HALF_BLOCK;
+      }
+    }
   }
 
-  bool push_buffer_bg(const std::vector<std::vector<std::array<int, 3>>>& rgb) {
+  bool push_buffer(int row, std::span<const char> buffer) {
     using namespace std;
     lock_guard<mutex> lock(data_mtx);
-    size_t rows = rgb.size();
-#pragma omp parallel for
-    for (size_t y = 0; y < rows; ++y)
-      for (size_t x = 0; x < rgb[y].size(); ++x)
-        backgroundRGB[y][x] = { static_cast<uint8_t>(rgb[y][x][0]),
-                                 static_cast<uint8_t>(rgb[y][x][1]),
-                                 static_cast<uint8_t>(rgb[y][x][2]) };
+    const Buffer& b = cur();
+    if (row < 0 || row >= b.height) return false;
+    const size_t n = min(buffer.size(), static_cast<size_t>(b.width));
+    copy_n(buffer.begin(), n, cur().data.begin() + static_cast<ptrdiff_t>(row) * b.width);
     return true;
   }
 
-  std::vector<std::vector<char>>& get_frame_buffer() {
-    using namespace std;
-    lock_guard<mutex> lock(data_mtx);
-    return data;
+  bool push_buffer(int row, std::initializer_list<char> buffer) {
+    return push_buffer(row, std::span<const char>(buffer.begin(), buffer.size()));
   }
 
+  /* Gambar back buffer langsung di thread pemanggil. Di mode async diteruskan
+   * ke present(), jadi kode lama yang memanggil render() ikut asinkron.     */
   void render() {
-#ifndef _WIN32
-    handle_resize();
-#endif
+    if (is_async()) {
+      present();
+      return;
+    }
 
     using namespace std;
     lock_guard<mutex> lock(data_mtx);
-
-    const int rows = height;
-    const int cols = width;
-
-    /* Satu string per baris — tiap thread OMP tulis ke indeks miliknya sendiri,
-     * tidak ada sharing sehingga tidak perlu mutex di dalam loop paralel.      */
-    vector<string> row_bufs(static_cast<size_t>(rows));
-
-    /* Estimasi kapasitas awal per baris: worst-case ~40 byte/sel */
-    const size_t row_cap = static_cast<size_t>(cols) * 40;
-
-#pragma omp parallel for schedule(static)
-    for (int y = 0; y < rows; ++y) {
-      string& s = row_bufs[static_cast<size_t>(y)];
-      s.reserve(row_cap);
-
-      /* Sentinel 256 = belum ada warna — paksa emit pada sel pertama */
-      constexpr uint16_t NONE = 256;
-      uint16_t cur_br = NONE, cur_bg_ = NONE, cur_bb = NONE;
-      uint16_t cur_fr = NONE, cur_fg_ = NONE, cur_fb = NONE;
-
-      for (int x = 0; x < cols; ++x) {
-        const auto& bg = backgroundRGB[static_cast<size_t>(y)][static_cast<size_t>(x)];
-        const auto& fg = foregroundRGB[static_cast<size_t>(y)][static_cast<size_t>(x)];
-
-        if (bg[0] != cur_br || bg[1] != cur_bg_ || bg[2] != cur_bb) {
-          ANSI::writeBgRGB(s, bg[0], bg[1], bg[2]);
-          cur_br = bg[0]; cur_bg_ = bg[1]; cur_bb = bg[2];
-        }
-
-        if (fg[0] != cur_fr || fg[1] != cur_fg_ || fg[2] != cur_fb) {
-          ANSI::writeFgRGB(s, fg[0], fg[1], fg[2]);
-          cur_fr = fg[0]; cur_fg_ = fg[1]; cur_fb = fg[2];
-        }
-
-        s += data[static_cast<size_t>(y)][static_cast<size_t>(x)];
-      }
-
-      if (y != rows - 1) s += '\n';
-    }
-
-    /* Hitung total size dengan reduction — lalu gabung serial (urutan harus terjaga) */
-    size_t total = 0;
-#pragma omp parallel for schedule(static) reduction(+ : total)
-    for (int y = 0; y < rows; ++y) total += row_bufs[static_cast<size_t>(y)].size();
-    ansiInstance.reserve(total + 32); /* +32 untuk home + reset */
-
-    ansiInstance.homeCursor();
-    for (auto& s : row_bufs) ansiInstance.append(s);
-    ansiInstance.reset();
-    ansiInstance.flush();
+#ifndef _WIN32
+    handle_resize();
+#endif
+    statPublished.fetch_add(1, memory_order_relaxed);
+    emit(cur());
   }
 };
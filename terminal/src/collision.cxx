@@ -84,7 +84,7 @@ int main(int argc, char** argv) {
 
   while (!stopFlag) {
     /* Re-fetch setiap frame — handle_resize() di dalam render() bisa
-     * realokasi vector (data.assign()), membuat referensi lama invalid. */
+     * mengganti ukuran plane, view dari frame lama tidak berlaku lagi. */
     int new_W = disp.get_width();
     int new_H = disp.get_height();
     if (new_W != W || new_H != H) {
@@ -96,8 +96,6 @@ int main(int argc, char** argv) {
       big.prevPos   = big.pos;
     }
 
-    auto& fb = disp.get_frame_buffer(); /* ambil referensi segar tiap frame */
-
     /* ── Fisika: sub-stepping dalam satu frame dt ──────────────────────── */
     int prevSmallX = static_cast<int>(floor(small.prevPos));
     int prevBigX   = static_cast<int>(floor(big.prevPos));
@@ -142,34 +140,41 @@ int main(int argc, char** argv) {
     }
 
     /* ── Render ────────────────────────────────────────────────────────── */
-    /* Hapus posisi lama */
-    if (prevSmallX >= 0 && prevSmallX < W) fb[mid][prevSmallX] = ' ';
-    if (prevBigX   >= 0 && prevBigX   < W) fb[mid][prevBigX]   = ' ';
-
-    /* Update prevPos */
-    small.prevPos = small.pos;
-    big.prevPos   = big.pos;
-
-    /* Dinding */
-    if (wallX >= 0 && wallX < W) fb[mid][wallX] = '|';
-
-    /* Benda */
-    int xs = static_cast<int>(floor(small.pos));
-    int xb = static_cast<int>(floor(big.pos));
-    if (xs >= 0 && xs < W) fb[mid][xs] = small.symbol;
-    if (xb >= 0 && xb < W) fb[mid][xb] = big.symbol;
-
-    /* HUD baris 0 */
-    string hud;
-    hud.reserve(128);
-    hud += "small m=";  hud += to_string(static_cast<long long>(small.mass));
-    hud += " v=";       hud += to_string(small.vel).substr(0, 7);
-    hud += "  big m=";  hud += to_string(static_cast<long long>(big.mass));
-    hud += " v=";       hud += to_string(big.vel).substr(0, 7);
-    hud += "  col=";    hud += to_string(totalCollision);
-
-    for (int i = 0; i < W; ++i)
-      fb[0][i] = (i < static_cast<int>(hud.size())) ? hud[i] : ' ';
+    {
+      /* Kunci frame sampai akhir blok, baris diakses lewat span tanpa salinan */
+      auto frame = disp.lock_frame();
+      auto line  = frame.chars.row(mid);
+      auto top   = frame.chars.row(0);
+
+      /* Hapus posisi lama */
+      if (prevSmallX >= 0 && prevSmallX < W) line[prevSmallX] = ' ';
+      if (prevBigX   >= 0 && prevBigX   < W) line[prevBigX]   = ' ';
+
+      /* Update prevPos */
+      small.prevPos = small.pos;
+      big.prevPos   = big.pos;
+
+      /* Dinding */
+      if (wallX >= 0 && wallX < W) line[wallX] = '|';
+
+      /* Benda */
+      int xs = static_cast<int>(floor(small.pos));
+      int xb = static_cast<int>(floor(big.pos));
+      if (xs >= 0 && xs < W) line[xs] = small.symbol;
+      if (xb >= 0 && xb < W) line[xb] = big.symbol;
+
+      /* HUD baris 0 */
+      string hud;
+      hud.reserve(128);
+      hud += "small m=";  hud += to_string(static_cast<long long>(small.mass));
+      hud += " v=";       hud += to_string(small.vel).substr(0, 7);
+      hud += "  big m=";  hud += to_string(static_cast<long long>(big.mass));
+      hud += " v=";       hud += to_string(big.vel).substr(0, 7);
+      hud += "  col=";    hud += to_string(totalCollision);
+
+      for (int i = 0; i < W; ++i)
+        top[i] = (i < static_cast<int>(hud.size())) ? hud[i] : ' ';
+    }
 
     disp.render();
     this_thread::sleep_for(chrono::milliseconds(16));
@@ -18,40 +18,135 @@
 */
 
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <csignal>
+#include <cstdio>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <opencv4/opencv2/opencv.hpp>
+#include <optional>
+#include <string>
 
 #include <thread>
 #include <vector>
 
 #include "display-term.hxx"
 
-static bool running = true;
-void        handle_sigint(int) { running = false; }
+static std::atomic<bool> running{true};
+void                     handle_sigint(int) { running = false; }
+
+/* Ringkasan playback, dicetak lewat atexit setelah Display keluar dari alternate screen */
+static std::string report;
+
+using Clock = std::chrono::steady_clock;
+
+/* Antrian FIFO berkapasitas tetap antar stage pipeline. push() menunggu kalau
+ * penuh (backpressure ke stage sebelumnya), pop() menunggu kalau kosong.
+ * close() membangunkan semua: push gagal, pop menghabiskan sisa lalu nullopt. */
+template <typename T>
+class BoundedQueue {
+  std::deque<T>           items;
+  size_t                  capacity;
+  bool                    closed = false;
+  std::mutex              mtx;
+  std::condition_variable notFull, notEmpty;
+
+ public:
+  explicit BoundedQueue(size_t cap) : capacity(cap) {}
+
+  bool push(T v) {
+    std::unique_lock<std::mutex> lock(mtx);
+    notFull.wait(lock, [&] { return closed || items.size() < capacity; });
+    if (closed) return false;
+    items.push_back(std::move(v));
+    notEmpty.notify_one();
+    return true;
+  }
+
+  std::optional<T> pop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    notEmpty.wait(lock, [&] { return closed || !items.empty(); });
+    if (items.empty()) return std::nullopt;
+    T v = std::move(items.front());
+    items.pop_front();
+    notFull.notify_one();
+    return v;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mtx);
+    closed = true;
+    notFull.notify_all();
+    notEmpty.notify_all();
+  }
+};
+
+/* Satu frame yang mengalir di pipeline: indeks sumber menentukan deadline
+ * tampil, decoded dipakai untuk mengukur latensi ujung ke ujung.           */
+struct VideoFrame {
+  long              index = 0;
+  Clock::time_point decoded;
+  cv::Mat           image;
+};
+
+/* Latensi per stage, hanya ditulis oleh thread stage itu sendiri */
+struct StageStats {
+  uint64_t count   = 0;
+  double   totalMs = 0, maxMs = 0;
+
+  void add(Clock::duration d) {
+    const double ms = std::chrono::duration<double, std::milli>(d).count();
+    ++count;
+    totalMs += ms;
+    maxMs    = std::max(maxMs, ms);
+  }
+  double avg() const { return count ? totalMs / double(count) : 0.0; }
+};
 
 int main(int argc, char* argv[]) {
   signal(SIGINT, handle_sigint);
   using namespace std;
   if (argc < 2) {
-    cerr << "Usage: " << argv[0] << " <video_file>\n";
+    cerr << "Usage: " << argv[0] << " <video_file> [--cells] [--256]\n"
+         << "  --cells  satu piksel per sel (default: half-block, 2 piksel vertikal per sel)\n"
+         << "  --256    kuantisasi ke palet xterm 256 (default: truecolor)\n";
     return 1;
   }
-  string           path = argv[1];
+  string path      = argv[1];
+  bool   halfBlock = true, palette = false;
+  for (int i = 2; i < argc; ++i) {
+    const string a = argv[i];
+    if (a == "--cells") halfBlock = false;
+    else if (a == "--256") palette = true;
+    else {
+      cerr << "Unknown option: " << a << "\n";
+      return 1;
+    }
+  }
+
   cv::VideoCapture cap(path);
   if (!cap.isOpened()) {
     cerr << "Failed to open video: " << path << "\n";
     return 1;
   }
-  Display&                      display = Display::getInstance();
-  int                           termW   = display.get_width();
-  int                           termH   = display.get_height();
-  vector<vector<array<int, 3>>> rgb(termH, vector<array<int, 3>>(termW, {0, 0, 0}));
-  int                           videoW      = (int)cap.get(cv::CAP_PROP_FRAME_WIDTH);
-  int                           videoH      = (int)cap.get(cv::CAP_PROP_FRAME_HEIGHT);
-  double                        videoAspect = double(videoW) / videoH;
-  double                        termAspect  = double(termW) / termH;
-  int                           renderW, renderH;
+  double fps = cap.get(cv::CAP_PROP_FPS);
+  if (!(fps > 0)) fps = 30.0;
+  const auto period = chrono::duration_cast<Clock::duration>(chrono::duration<double>(1.0 / fps));
+
+  /* Didaftarkan sebelum Display dibuat → dipanggil sesudah destructor Display */
+  atexit([] { fputs(report.c_str(), stderr); });
+
+  Display& display     = Display::getInstance();
+  int      termW       = display.get_width();
+  int      termH       = halfBlock ? display.get_pixel_height() : display.get_height();
+  int      videoW      = (int)cap.get(cv::CAP_PROP_FRAME_WIDTH);
+  int      videoH      = (int)cap.get(cv::CAP_PROP_FRAME_HEIGHT);
+  double   videoAspect = double(videoW) / videoH;
+  double   termAspect  = double(termW) / termH;
+  int      renderW, renderH;
   if (videoAspect > termAspect) {
     renderW = termW;
     renderH = int(termW / videoAspect);
@@ -59,29 +154,98 @@ int main(int argc, char* argv[]) {
     renderH = termH;
     renderW = int(termH * videoAspect);
   }
-  int     offsetX = (termW - renderW) / 2;
-  int     offsetY = (termH - renderH) / 2;
-  cv::Mat frame, resized;
-  while (cap.read(frame)) {
+  int offsetX = (termW - renderW) / 2;
+  int offsetY = (termH - renderH) / 2;
+  if (palette) display.set_color_mode(Display::COLOR_MODE::PALETTE_256);
+
+  /* Pipeline tiga stage, masing-masing thread sendiri:
+   *   decode (cap.read) → scale (resize + BGR→RGB) → present (thread ini)
+   * lalu tulis terminal di render thread Display. Antrian kecil supaya
+   * latensi tetap rendah tapi jitter decode masih teredam.              */
+  BoundedQueue<VideoFrame> decodedQ(4), scaledQ(4);
+  StageStats               decodeStats, scaleStats, presentStats;
+
+  thread decoder([&] {
+    for (long i = 0; running; ++i) {
+      VideoFrame f;
+      const auto t0 = Clock::now();
+      if (!cap.read(f.image)) break;
+      f.decoded = Clock::now();
+      f.index   = i;
+      decodeStats.add(f.decoded - t0);
+      if (!decodedQ.push(std::move(f))) break;
+    }
+    decodedQ.close();
+  });
+
+  thread scaler([&] {
+    cv::Mat resized;
+    while (auto f = decodedQ.pop()) {
+      const auto t0 = Clock::now();
+      /* Resize dulu baru konversi warna — cvtColor jalan di gambar yang sudah kecil */
+      cv::resize(f->image, resized, cv::Size(renderW, renderH), 0, 0, cv::INTER_AREA);
+      cv::Mat rgb;
+      cv::cvtColor(resized, rgb, cv::COLOR_BGR2RGB);
+      f->image = std::move(rgb);
+      scaleStats.add(Clock::now() - t0);
+      if (!scaledQ.push(std::move(*f))) break;
+    }
+    scaledQ.close();
+    decodedQ.close();
+  });
+
+  /* Present dijadwalkan pada jam monotonic: frame i jatuh tempo di start + i·period.
+   * Frame yang sudah lewat lebih dari satu periode dibuang, jadi playback mengejar
+   * waktu nyata alih-alih melambat; frame yang terlalu awal ditunggu sampai deadline. */
+  display.start_async(fps);
+  Clock::time_point start;
+  bool              started   = false;
+  uint64_t          presented = 0, late = 0;
+  while (auto f = scaledQ.pop()) {
     if (!running) break;
-    cv::cvtColor(frame, frame, cv::COLOR_BGR2RGB);
-    cv::resize(frame, resized, cv::Size(renderW, renderH), 0, 0, cv::INTER_AREA);
-#pragma omp parallel for
-    for (int y = 0; y < termH; ++y)
-      for (int x = 0; x < termW; ++x) rgb[y][x] = {0, 0, 0};
-#pragma omp parallel for
-    for (int y = 0; y < renderH; ++y) {
-      const cv::Vec3b* ptr = resized.ptr<cv::Vec3b>(y);
-      for (int x = 0; x < renderW; ++x) {
-        const cv::Vec3b& c            = ptr[x];
-        rgb[y + offsetY][x + offsetX] = {c[0], c[1], c[2]};
-      }
+    if (!started) {
+      start   = Clock::now() - f->index * period;
+      started = true;
+    }
+    const auto due = start + f->index * period;
+    const auto now = Clock::now();
+    if (now > due + period) {
+      ++late;
+      continue;
     }
-    display.push_buffer_bg(rgb);
-    display.render();
-    int delay = (int)(1000.0 / cap.get(cv::CAP_PROP_FPS));
-    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    this_thread::sleep_until(due);
+
+    if (halfBlock)
+      display.blit_pixels(f->image.ptr<uint8_t>(0), renderW, renderH, f->image.step, offsetX, offsetY);
+    else
+      display.blit_background(f->image.ptr<uint8_t>(0), renderW, renderH, f->image.step, offsetX, offsetY);
+    /* Seluruh area video ditimpa tiap frame, letterbox tetap hitam di ketiga buffer —
+     * tidak perlu salin frame lama ke back buffer baru.                          */
+    display.present(false);
+    presentStats.add(Clock::now() - f->decoded);
+    ++presented;
   }
+  running = false;
+  scaledQ.close();
+  decodedQ.close();
+  scaler.join();
+  decoder.join();
+
+  display.stop_async();
+  const auto disp = display.present_stats();
+
+  char line[160];
+  snprintf(line, sizeof line, "frames      : %lu presented, %lu dropped late (%.2f fps source)\n", (unsigned long)presented, (unsigned long)late, fps);
+  report += line;
+  snprintf(line, sizeof line, "decode      : avg %.2f ms, max %.2f ms\n", decodeStats.avg(), decodeStats.maxMs);
+  report += line;
+  snprintf(line, sizeof line, "scale+color : avg %.2f ms, max %.2f ms\n", scaleStats.avg(), scaleStats.maxMs);
+  report += line;
+  snprintf(line, sizeof line, "decode→show : avg %.2f ms, max %.2f ms\n", presentStats.avg(), presentStats.maxMs);
+  report += line;
+  snprintf(line, sizeof line, "terminal    : %lu drawn, %lu superseded, avg %.2f ms/frame\n", (unsigned long)disp.presented,
+           (unsigned long)disp.dropped, disp.avgMs);
+  report += line;
 
   return 0;
 }
@@ -40,34 +40,30 @@ int main() {
   printf("debug : rendering on scale %d,%d\n", w, h);
   this_thread::sleep_for(2s);
 
-  /* rgbBuffer dialokasikan ulang saat resize */
-  vector<vector<array<int, 3>>> rgbBuffer(h, vector<array<int, 3>>(w));
-
   float t = 0.0f;
   while (running) {
-    /* Deteksi resize: ambil dimensi terbaru dari Display.
-       Display::render() sudah menangani resize internal buffer-nya
-       via SIGWINCH handler; kita tinggal sinkronkan w/h lokal. */
-    int new_w = disp.get_width();
-    int new_h = disp.get_height();
-    if (new_w != w || new_h != h) {
-      w = new_w;
-      h = new_h;
-      rgbBuffer.assign(h, vector<array<int, 3>>(w));
-    }
+    /* Tulis gradien langsung ke plane background lewat view — tanpa buffer
+       perantara. Dimensi diambil dari view, jadi resize via SIGWINCH di
+       Display::render() otomatis ikut pada frame berikutnya.              */
+    {
+      auto        frame = disp.lock_frame();
+      const auto& bg    = frame.background;
+      w                 = bg.width;
+      h                 = bg.height;
 
 #pragma omp parallel for schedule(static)
-    for (int y = 0; y < h; ++y) {
-      const float yf = y / float(h - 1 > 0 ? h - 1 : 1);
-      for (int x = 0; x < w; ++x) {
-        const float xf      = x / float(w - 1 > 0 ? w - 1 : 1);
-        rgbBuffer[y][x][0]  = int((sinf(t + xf * 3.1415f)         * 0.5f + 0.5f) * 255);
-        rgbBuffer[y][x][1]  = int((sinf(t + yf * 3.1415f + 2.0f)  * 0.5f + 0.5f) * 255);
-        rgbBuffer[y][x][2]  = int((sinf(t + xf * 3.1415f + 4.0f)  * 0.5f + 0.5f) * 255);
+      for (int y = 0; y < h; ++y) {
+        const float yf  = y / float(h - 1 > 0 ? h - 1 : 1);
+        auto        row = bg.row(y);
+        for (int x = 0; x < w; ++x) {
+          const float xf = x / float(w - 1 > 0 ? w - 1 : 1);
+          row[x]         = {uint8_t((sinf(t + xf * 3.1415f)        * 0.5f + 0.5f) * 255),
+                            uint8_t((sinf(t + yf * 3.1415f + 2.0f) * 0.5f + 0.5f) * 255),
+                            uint8_t((sinf(t + xf * 3.1415f + 4.0f) * 0.5f + 0.5f) * 255)};
+        }
       }
     }
 
-    disp.push_buffer_bg(rgbBuffer);
     disp.render();
 
     t += 0.05f;